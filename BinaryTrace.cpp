@@ -0,0 +1,108 @@
+#include "BinaryTrace.hpp"
+
+void BinaryTraceEncoder::open(TraceWriter* writer, const MemoryGeometry& geometry) {
+    this->out = writer;
+    this->last_cycle = 0;
+    this->string_ids.clear();
+    this->physical_shadow.assign(geometry.physical_memory_size, {-1, -1});
+    this->virtual_shadow.clear();
+
+    this->out->write(BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC));
+    this->out->write_varint(geometry.virtual_memory_size);
+    this->out->write_varint(geometry.physical_memory_size);
+    this->out->write_varint(geometry.print_frame_unit);
+}
+
+void BinaryTraceEncoder::write_string(const std::string& str) {
+    auto it = this->string_ids.find(str);
+    if (it != this->string_ids.end()) {
+        this->out->write_varint(it->second + 1);
+        return;
+    }
+
+    this->string_ids.emplace(str, static_cast<int>(this->string_ids.size()));
+    this->out->write_varint(0);
+    this->out->write_varint(str.size());
+    this->out->write(str);
+}
+
+void BinaryTraceEncoder::record(const Status& status) {
+    const Process* running = status.process_running;
+
+    // 종료된 프로세스의 가상 메모리 기록은 더 쓰이지 않으므로 삭제 (같은 pid가 다시 실행되면 새 프로세스로 기록)
+    if (status.process_terminated != nullptr) {
+        this->virtual_shadow.erase(status.process_terminated->pid);
+    }
+
+    uint8_t flag = 0;
+    if (status.mode == USER_MODE_STRING) flag |= TRACE_FLAG_USER_MODE;
+    if (running != nullptr) {
+        flag |= TRACE_FLAG_RUNNING;
+        if (this->virtual_shadow.find(running->pid) == this->virtual_shadow.end()) {
+            flag |= TRACE_FLAG_NEW_PROCESS;
+        }
+    }
+
+    this->out->write_varint(status.cycle - this->last_cycle);
+    this->last_cycle = status.cycle;
+    this->out->write(static_cast<char>(flag));
+    this->write_string(*status.command);
+
+    if (running != nullptr) {
+        this->out->write_varint(running->pid);
+        if (flag & TRACE_FLAG_NEW_PROCESS) {
+            this->out->write_varint(running->ppid);
+            this->write_string(running->name);
+        }
+    }
+
+    // 물리 메모리 변경분
+    this->changed.clear();
+    const FrameTable& frames = status.physical_memory;
+    for (int i = 0; i < status.geometry.physical_memory_size; i++) {
+        std::pair<int, int> current = !frames.is_occupied(i) ? std::make_pair(-1, -1)
+                                                             : std::make_pair(frames.process_id[i], frames.page_id[i]);
+        if (current != this->physical_shadow[i]) {
+            this->physical_shadow[i] = current;
+            this->changed.push_back(i);
+        }
+    }
+    this->out->write_varint(this->changed.size());
+    for (int i: this->changed) {
+        this->out->write_varint(i);
+        this->out->write_varint(this->physical_shadow[i].first + 1);
+        if (this->physical_shadow[i].first != -1) {
+            this->out->write_varint(this->physical_shadow[i].second);
+        }
+    }
+
+    if (running == nullptr) return;
+
+    // 실행중인 프로세스의 가상 메모리 및 페이지 테이블 변경분
+    auto& shadow = this->virtual_shadow[running->pid];
+    if (shadow.empty()) shadow.resize(status.geometry.virtual_memory_size);
+
+    this->changed.clear();
+    for (int i = 0; i < status.geometry.virtual_memory_size; i++) {
+        VirtualCell current;
+        current.page_id = running->virtual_memory[i];
+        const PageTableEntry* pe = running->page_table[i];
+        if (pe != nullptr) {
+            current.authority = pe->authority;
+            current.physical_address = pe->physical_address;
+        }
+        if (!(current == shadow[i])) {
+            shadow[i] = current;
+            this->changed.push_back(i);
+        }
+    }
+    this->out->write_varint(this->changed.size());
+    for (int i: this->changed) {
+        this->out->write_varint(i);
+        this->out->write_signed_varint(shadow[i].page_id);
+        this->out->write(shadow[i].authority);
+        if (shadow[i].authority != 0) {
+            this->out->write_signed_varint(shadow[i].physical_address);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef HW3_BINARY_TRACE_HPP
+#define HW3_BINARY_TRACE_HPP
+
+#include "System.hpp"
+#include "Trace.hpp"
+#include <unordered_map>
+
+/**
+ * 바이너리 trace 인코더\n
+ * 파일 형식 (정수는 모두 LEB128 varint, 부호 있는 값은 zigzag)\n
+ * header: BINARY_TRACE_MAGIC, 가상 메모리 크기, 물리 메모리 크기, 출력 프레임 단위\n
+ * cycle record:\n
+ *  - cycle 증가량, flag (TRACE_FLAG_*), command 문자열 참조\n
+ *  - TRACE_FLAG_RUNNING 이면 실행중인 pid, TRACE_FLAG_NEW_PROCESS 이면 ppid 및 이름 문자열 참조\n
+ *  - 바뀐 물리 프레임 수, 각 프레임마다 인덱스, pid + 1 (0이면 빈 프레임), page id\n
+ *  - TRACE_FLAG_RUNNING 이면 바뀐 가상 메모리 칸 수, 각 칸마다 인덱스, page id, 권한(0이면 엔트리 없음), 물리 주소\n
+ * 문자열 참조: 0이면 새 문자열 (길이 + 바이트)이 뒤따르고 다음 id를 부여, 그 외에는 id + 1
+ */
+class BinaryTraceEncoder {
+private:
+    /**
+     * 실행중인 프로세스의 가상 메모리 한 칸에서 출력되는 정보
+     */
+    struct VirtualCell {
+        int page_id = -1;
+        char authority = 0; // 0이면 페이지 테이블 엔트리 없음
+        int physical_address = -1;
+
+        bool operator==(const VirtualCell& other) const {
+            return page_id == other.page_id && authority == other.authority
+                   && physical_address == other.physical_address;
+        }
+    };
+
+    TraceWriter* out = nullptr;
+    int last_cycle = 0;
+
+    std::unordered_map<std::string, int> string_ids;
+    // 마지막으로 기록한 물리 메모리 (pid, page id), pid -1은 빈 프레임
+    std::vector<std::pair<int, int>> physical_shadow;
+    // 실행 중인 프로세스별로 마지막으로 기록한 가상 메모리 (종료되면 삭제)
+    std::unordered_map<int, std::vector<VirtualCell>> virtual_shadow;
+
+    // 변경분 임시 저장 (매 cycle 재사용)
+    std::vector<int> changed;
+
+    void write_string(const std::string& str);
+
+public:
+    /**
+     * 헤더 기록 후 인코딩 시작
+     * @param writer 출력 writer
+     * @param geometry 메모리 구성
+     */
+    void open(TraceWriter* writer, const MemoryGeometry& geometry);
+
+    /**
+     * 현재 cycle의 상태를 이전 기록과의 차이로 기록
+     * @param status 현재 상태
+     */
+    void record(const Status& status);
+};
+
+#endif //HW3_BINARY_TRACE_HPP
@@ -4,49 +4,41 @@
 
 #include "System.hpp"
 #include "Run.hpp"
-#include <algorithm>
 #include <cassert>
 
-using namespace Run;
-
-void page_fault_handler(int page_id) {
+void page_fault_handler(Simulator &sim, int page_id) {
+    Status &status = sim.status;
     Process *p = status.process_running;
+    status.stats.page_faults++;
+    status.stats.process(p->pid, p->name).page_faults++;
 
-    int virtual_address = std::distance(p->virtual_memory.begin(),
-                                        std::find(p->virtual_memory.begin(),
-                                                  p->virtual_memory.end(),
-                                                  page_id));
+    int virtual_address = p->virtual_address_of(page_id);
     auto &target_pe = p->page_table[virtual_address];
     int target_frame_pid = p->pid;
     if (target_pe->authority == 'R' && p->pid != 1) {
         target_frame_pid = p->ppid;
     }
 
+    // 교체 기록(ghost list)을 쓰는 정책은 교체 대상을 고르기 전에 폴트가 난 페이지를 확인
+    status.replacer->faulted(page_key(target_frame_pid, page_id));
+
     // 물리 메모리에 공간이 없다면 페이지 교체
     if (status.free_memory_size() <= 0) {
         status.replace_page();
     }
-    int physical_address_to_allocate = status.free_memory_addresses(1).front();
+    int physical_address_to_allocate = status.first_free_memory_address();
 
     // 스왑 영역에서 프레임 찾고 물리 메모리에 할당
-    int swap_address = -1;
-    PhysicalFrame *frame;
-    for (size_t i = 0; i < status.swap_space.size(); i++) {
-        frame = status.swap_space[i];
-        if (frame == nullptr) continue;
-        if (frame->page_id == page_id && frame->process_id == target_frame_pid) {
-            swap_address = i;
-            status.physical_memory[physical_address_to_allocate] = frame;
-            frame->fi_score = status.top_fi_score++;
-            frame->fu_score++;
-            frame->ru_score = status.top_ru_score++;
-            frame->linked_page->physical_address = physical_address_to_allocate;
-            break;
-        }
-    }
+    PhysicalFrame *frame = status.swap_space.take(target_frame_pid, page_id);
+    assert(frame != nullptr);
+    status.stats.swap_ins++;
 
-    assert(swap_address != -1);
-    status.swap_space.erase(status.swap_space.begin() + swap_address);
+    frame->fi_score = status.top_fi_score++;
+    frame->fu_score++;
+    frame->ru_score = status.top_ru_score++;
+    frame->linked_page->physical_address = physical_address_to_allocate;
+    status.place_frame(physical_address_to_allocate, *frame);
+    status.frame_pool.destroy(frame);
 
     status.fault_handler_type = None;
 
@@ -56,87 +48,73 @@ void page_fault_handler(int page_id) {
     status.process_running = nullptr;
 }
 
-void protection_fault_handler(int page_id) {
+void protection_fault_handler(Simulator &sim, int page_id) {
+    Status &status = sim.status;
     Process *p = status.process_running;
+    status.stats.protection_faults++;
+    status.stats.process(p->pid, p->name).protection_faults++;
 
-    long virtual_address = std::distance(p->virtual_memory.begin(),
-                                         std::find(p->virtual_memory.begin(),
-                                                   p->virtual_memory.end(),
-                                                   page_id));
+    int virtual_address = p->virtual_address_of(page_id);
     auto &target_pe = p->page_table[virtual_address];
 
     int target_frame_pid = p->ppid;
     if (p->pid == 1) target_frame_pid = p->pid;
 
     // 공유하고 있던 프레임 찾기
-    PhysicalFrame *shared_frame;
+    int shared_frame_pid;
     if (target_pe->physical_address == -1) {
         // 스왑 영역에 있는 경우
-        for (const auto &frame: status.swap_space) {
-            if (frame == nullptr) continue;
-            if (frame->process_id == target_frame_pid && frame->page_id == page_id) {
-                shared_frame = frame;
-                break;
-            }
-        }
+        shared_frame_pid = status.swap_space.find(target_frame_pid, page_id)->process_id;
     } else {
-        shared_frame = status.physical_memory[target_pe->physical_address];
+        shared_frame_pid = status.physical_memory.process_id[target_pe->physical_address];
     }
 
-    auto parent_process = status.get_process_by_pid(shared_frame->process_id);
-    auto child_processes = status.get_child_processes(shared_frame->process_id);
-
+    auto parent_process = status.get_process_by_pid(shared_frame_pid);
 
     // 자식 프로세스들에서 공유하고 있는 페이지 복사 (할당 x)
-    for (auto &child: child_processes) {
-        for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
-            if (child->virtual_memory[i] == page_id) {
-                auto &pe = child->page_table[i];
-                if (pe->authority != 'R') continue;
-                pe = new PageTableEntry(-1, pe->allocation_id);
-                status.swap_space.push_back(new PhysicalFrame(child->pid, page_id));
-                status.swap_space.back()->linked_page = pe;
-                break;
-            }
-        }
+    // 같은 페이지 테이블 엔트리를 공유하는 프로세스만 확인 (target_pe는 복사 중에 바뀔 수 있으므로 미리 저장)
+    PageTableEntry *shared_pe = target_pe;
+    auto sharers = status.page_sharers.of(shared_pe);
+    for (auto &child: sharers) {
+        if (child->ppid != shared_frame_pid) continue;
+        int child_virtual_address = child->virtual_address_of(page_id);
+        if (child_virtual_address == -1) continue;
+
+        auto &pe = child->page_table[child_virtual_address];
+        if (pe != shared_pe) continue;
+        status.page_sharers.unshare(pe, child);
+        pe = status.page_pool.create(-1, pe->allocation_id);
+        status.page_sharers.share(pe, child);
+        auto *copied_frame = status.frame_pool.create(child->pid, page_id);
+        copied_frame->linked_page = pe;
+        status.swap_space.push_back(copied_frame);
+        status.stats.protection_fault_copies++;
     }
 
-    if (shared_frame->process_id != p->pid) {
+    if (shared_frame_pid != p->pid) {
         // 자식 프로세스로 인해 fault가 발생한 경우 해당 프레임 새로 할당
         if (status.free_memory_size() <= 0) {
             status.replace_page();
         }
-        int physical_address_to_allocate = status.free_memory_addresses(1).front();
-
-        PhysicalFrame *copied_new_frame = nullptr;
-        int iteration = -1;
-        for (const auto &frame: status.swap_space) {
-            iteration++;
-            if (frame == nullptr) continue;
-            if (frame->process_id == p->pid && frame->page_id == page_id) {
-                copied_new_frame = frame;
-                break;
-            }
-        }
+        int physical_address_to_allocate = status.first_free_memory_address();
 
+        PhysicalFrame *copied_new_frame = status.swap_space.take(p->pid, page_id);
         assert(copied_new_frame != nullptr);
-
-        status.swap_space.erase(status.swap_space.begin() + iteration);
+        status.stats.swap_ins++;
 
         copied_new_frame->fi_score = status.top_fi_score++;
         copied_new_frame->fu_score++;
         copied_new_frame->ru_score = status.top_ru_score++;
 
-        status.physical_memory[physical_address_to_allocate] = copied_new_frame;
+        status.place_frame(physical_address_to_allocate, *copied_new_frame);
+        status.frame_pool.destroy(copied_new_frame);
         target_pe->physical_address = physical_address_to_allocate;
     }
 
     if (p->pid != 1) {
-        for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
-            if (parent_process->virtual_memory[i] == page_id) {
-                parent_process->page_table[i]->authority = 'W';
-                break;
-            }
+        int parent_virtual_address = parent_process->virtual_address_of(page_id);
+        if (parent_virtual_address != -1) {
+            parent_process->page_table[parent_virtual_address]->authority = 'W';
         }
     } else {
         target_pe->authority = 'W';
@@ -150,16 +128,14 @@ void protection_fault_handler(int page_id) {
     status.process_running = nullptr;
 }
 
-void fault_handler() {
-    int num_arg;
+void fault_handler(Simulator &sim) {
+    Status &status = sim.status;
     switch (status.fault_handler_type) {
         case Page_fault:
-            num_arg = stoi(status.syscall_arg);
-            page_fault_handler(num_arg);
+            page_fault_handler(sim, status.syscall_arg);
             break;
         case Protection_fault:
-            num_arg = stoi(status.syscall_arg);
-            protection_fault_handler(num_arg);
+            protection_fault_handler(sim, status.syscall_arg);
             break;
         default:
             break;
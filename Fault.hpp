@@ -5,6 +5,8 @@
 #ifndef HW3_FAULT_HPP
 #define HW3_FAULT_HPP
 
+struct Simulator;
+
 enum fault_type {
     Page_fault,
     Protection_fault,
@@ -13,16 +15,22 @@ enum fault_type {
 
 /**
  * 페이지 플트 핸들러
+ * @param sim 실행 중인 시뮬레이터
  * @param page_id 물리 메모리로 가져와야 하는 page_id
  */
-void page_fault_handler(int page_id);
+void page_fault_handler(Simulator &sim, int page_id);
 
 /**
  * 프로텍션 폴트 핸들러
+ * @param sim 실행 중인 시뮬레이터
  * @param page_id 읽기 권한만 있는 page_id
  */
-void protection_fault_handler(int page_id);
+void protection_fault_handler(Simulator &sim, int page_id);
 
-void fault_handler();
+/**
+ * status의 fault_handler_type을 보고 폴트를 처리
+ * @param sim 실행 중인 시뮬레이터
+ */
+void fault_handler(Simulator &sim);
 
 #endif //HW3_FAULT_HPP
@@ -0,0 +1,43 @@
+#include "FrameAllocator.hpp"
+
+/**
+ * frame_count개 중 word 하나에 실제로 존재하는 프레임에 해당하는 비트
+ */
+static uint64_t valid_mask(int word, int frame_count) {
+    int remaining = frame_count - word * 64;
+    if (remaining >= 64) return ~uint64_t(0);
+    return (uint64_t(1) << remaining) - 1;
+}
+
+FrameAllocator::FrameAllocator(int frame_count) : frame_count(frame_count), free_count(frame_count) {
+    int words = (frame_count + WORD_BITS - 1) / WORD_BITS;
+    free_bits.resize(words);
+    for (int w = 0; w < words; w++) {
+        free_bits[w] = valid_mask(w, frame_count);
+    }
+}
+
+int FrameAllocator::first_free() const {
+    for (size_t w = 0; w < free_bits.size(); w++) {
+        if (free_bits[w] != 0) {
+            return static_cast<int>(w) * WORD_BITS + __builtin_ctzll(free_bits[w]);
+        }
+    }
+    return -1;
+}
+
+void FrameAllocator::lowest_free(int num, std::vector<int>& out) const {
+    for (size_t w = 0; w < free_bits.size() && num > 0; w++) {
+        uint64_t bits = free_bits[w];
+        int available = __builtin_popcountll(bits);
+        if (available == 0) continue;
+
+        int take = available < num ? available : num;
+        for (int i = 0; i < take; i++) {
+            out.push_back(static_cast<int>(w) * WORD_BITS + __builtin_ctzll(bits));
+            // 가장 낮은 1 비트 제거
+            bits &= bits - 1;
+        }
+        num -= take;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef HW3_FRAME_ALLOCATOR_HPP
+#define HW3_FRAME_ALLOCATOR_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * 물리 메모리의 빈 프레임을 비트맵으로 관리\n
+ * 비트가 1이면 빈 프레임이며, 빈 프레임 수는 따로 유지해서 O(1)에 조회한다.
+ * 빈 주소는 64비트 word 단위로 popcount로 빈 word를 건너뛰고 count-trailing-zeros로 오름차순으로 찾는다.
+ */
+class FrameAllocator {
+private:
+    static const int WORD_BITS = 64;
+
+    std::vector<uint64_t> free_bits;
+    int frame_count;
+    int free_count;
+
+public:
+    explicit FrameAllocator(int frame_count);
+
+    /**
+     * 프레임을 사용 중으로 표시
+     * @param address 물리 메모리 주소
+     */
+    void occupy(int address) {
+        free_bits[address / WORD_BITS] &= ~(uint64_t(1) << (address % WORD_BITS));
+        free_count--;
+    }
+
+    /**
+     * 프레임을 빈 프레임으로 표시
+     * @param address 물리 메모리 주소
+     */
+    void release(int address) {
+        free_bits[address / WORD_BITS] |= uint64_t(1) << (address % WORD_BITS);
+        free_count++;
+    }
+
+    bool is_free(int address) const {
+        return (free_bits[address / WORD_BITS] >> (address % WORD_BITS)) & 1;
+    }
+
+    int free_size() const {
+        return free_count;
+    }
+
+    /**
+     * 가장 낮은 빈 주소
+     * @return 물리 메모리 주소, 빈 프레임이 없으면 -1
+     */
+    int first_free() const;
+
+    /**
+     * 낮은 주소부터 빈 주소를 num개 찾아 out에 오름차순으로 추가
+     * @param num 찾을 주소 수 (free_size() 이하)
+     * @param out 결과를 추가할 vector
+     */
+    void lowest_free(int num, std::vector<int>& out) const;
+};
+
+#endif //HW3_FRAME_ALLOCATOR_HPP
@@ -0,0 +1,40 @@
+#include "FrameTable.hpp"
+#include "System.hpp"
+#include "ScoreSearch.hpp"
+
+FrameTable::FrameTable(int frame_count)
+        : process_id(frame_count, -1), page_id(frame_count, -1), linked_page(frame_count, nullptr),
+          ru_score(frame_count, 0), fi_score(frame_count, 0), fu_score(frame_count, 0), referenced(frame_count, 0),
+          occupied(frame_count, 0) {}
+
+void FrameTable::store(int address, const PhysicalFrame& frame) {
+    process_id[address] = frame.process_id;
+    page_id[address] = frame.page_id;
+    linked_page[address] = frame.linked_page;
+    ru_score[address] = frame.ru_score;
+    fi_score[address] = frame.fi_score;
+    fu_score[address] = frame.fu_score;
+    referenced[address] = 1;
+    occupied[address] = 1;
+}
+
+PhysicalFrame FrameTable::load(int address) const {
+    PhysicalFrame frame(process_id[address], page_id[address], fi_score[address], fu_score[address],
+                        ru_score[address]);
+    frame.linked_page = linked_page[address];
+    return frame;
+}
+
+void FrameTable::clear(int address) {
+    occupied[address] = 0;
+    referenced[address] = 0;
+    linked_page[address] = nullptr;
+}
+
+int FrameTable::min_score_address(const std::vector<int>& score) const {
+    return score_search().argmin(score.data(), occupied.data(), this->size());
+}
+
+int FrameTable::max_score_address(const std::vector<int>& score) const {
+    return score_search().argmax(score.data(), occupied.data(), this->size());
+}
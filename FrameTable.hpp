@@ -0,0 +1,69 @@
+#ifndef HW3_FRAME_TABLE_HPP
+#define HW3_FRAME_TABLE_HPP
+
+#include <vector>
+#include <cstdint>
+
+struct PhysicalFrame;
+struct PageTableEntry;
+
+/**
+ * 물리 메모리 프레임 테이블 (structure of arrays)\n
+ * 필드마다 주소로 인덱싱되는 연속 배열을 두고, 사용 중인 프레임은 occupied 마스크(1 = 사용 중)로 표시한다.
+ * 교체 대상 탐색은 점수 배열 하나와 마스크만 훑으며, CPU에 맞는 SIMD 커널(ScoreSearch)로 실행된다.
+ */
+struct FrameTable {
+    std::vector<int> process_id;
+    std::vector<int> page_id;
+    std::vector<PageTableEntry*> linked_page;
+    // 높을수록 최근에 접근된 메모리
+    std::vector<int> ru_score;
+    // 높을수록 최근에 삽입된 메모리
+    std::vector<int> fi_score;
+    // 높을수록 많이 접근된 메모리
+    std::vector<int> fu_score;
+    // 참조 비트 (배치되거나 접근되면 1, CLOCK 계열 정책의 hand가 지나가며 0으로 지움)
+    std::vector<uint8_t> referenced;
+    std::vector<uint8_t> occupied;
+
+    explicit FrameTable(int frame_count = 0);
+
+    int size() const { return (int) occupied.size(); }
+
+    bool is_occupied(int address) const { return occupied[address] != 0; }
+
+    /**
+     * 프레임의 필드를 테이블에 복사하고 사용 중, 참조됨으로 표시
+     * @param address 물리 메모리 주소
+     * @param frame 배치할 프레임
+     */
+    void store(int address, const PhysicalFrame& frame);
+
+    /**
+     * 테이블에 있는 프레임의 필드를 읽어 옴
+     * @param address 물리 메모리 주소 (사용 중이어야 함)
+     */
+    PhysicalFrame load(int address) const;
+
+    /**
+     * 빈 프레임으로 표시
+     * @param address 물리 메모리 주소
+     */
+    void clear(int address);
+
+    /**
+     * 사용 중인 프레임 중 점수가 가장 낮은 주소 (동점이면 가장 낮은 주소)
+     * @param score 점수 배열 (ru_score, fi_score, fu_score 중 하나)
+     * @return 물리 메모리 주소, 사용 중인 프레임이 없으면 -1
+     */
+    int min_score_address(const std::vector<int>& score) const;
+
+    /**
+     * 사용 중인 프레임 중 점수가 가장 높은 주소 (동점이면 가장 낮은 주소)
+     * @param score 점수 배열 (ru_score, fi_score, fu_score 중 하나)
+     * @return 물리 메모리 주소, 사용 중인 프레임이 없으면 -1
+     */
+    int max_score_address(const std::vector<int>& score) const;
+};
+
+#endif //HW3_FRAME_TABLE_HPP
@@ -0,0 +1,138 @@
+#ifndef HW3_POOL_HPP
+#define HW3_POOL_HPP
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+/**
+ * 한 시뮬레이션 동안 같은 타입의 객체를 소유하는 free list 풀\n
+ * 객체는 CHUNK_SIZE개씩 연속된 chunk에 만들어지므로 주소와 slot 번호(index)가 바뀌지 않는다.
+ * 해제된 slot은 free list로 다시 쓰며, 풀이 소멸되거나 reset되면 남은 객체를 한꺼번에 정리한다.
+ * (소멸자가 필요 없는 타입은 reset이 O(1))
+ * @tparam T 객체 타입
+ */
+template<typename T>
+class ObjectPool {
+private:
+    static const size_t CHUNK_SIZE = 256;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t index;
+        bool live;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    std::vector<uint32_t> free_slots;
+    // 한 번이라도 사용된 slot 수 (새 slot은 이 위치부터 꺼냄)
+    size_t used = 0;
+    size_t live_count = 0;
+
+    Slot& slot_at(size_t index) {
+        return chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+    }
+
+    static Slot* slot_of(T* object) {
+        return reinterpret_cast<Slot*>(object);
+    }
+
+public:
+    ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&) = delete;
+
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ObjectPool(ObjectPool&& other) noexcept {
+        this->swap(other);
+    }
+
+    // 기존 객체는 other로 넘어가 other가 소멸될 때 정리된다
+    ObjectPool& operator=(ObjectPool&& other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    ~ObjectPool() {
+        this->reset();
+    }
+
+    void swap(ObjectPool& other) noexcept {
+        std::swap(chunks, other.chunks);
+        std::swap(free_slots, other.free_slots);
+        std::swap(used, other.used);
+        std::swap(live_count, other.live_count);
+    }
+
+    /**
+     * 풀에 객체 생성
+     * @param args 생성자 인자
+     * @return 생성된 객체 (풀이 소유)
+     */
+    template<typename... Args>
+    T* create(Args&&... args) {
+        size_t index;
+        if (!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            if (used == chunks.size() * CHUNK_SIZE) {
+                chunks.push_back(std::unique_ptr<Slot[]>(new Slot[CHUNK_SIZE]));
+            }
+            index = used++;
+        }
+        Slot& slot = slot_at(index);
+        T* object = new (slot.storage) T(std::forward<Args>(args)...);
+        slot.index = (uint32_t) index;
+        slot.live = true;
+        live_count++;
+        return object;
+    }
+
+    /**
+     * 객체를 소멸시키고 slot을 free list에 반환 (nullptr이면 무시)
+     * @param object 이 풀에서 만든 객체
+     */
+    void destroy(T* object) {
+        if (object == nullptr) return;
+        Slot* slot = slot_of(object);
+        object->~T();
+        slot->live = false;
+        free_slots.push_back(slot->index);
+        live_count--;
+    }
+
+    /**
+     * 객체의 slot 번호 (객체가 살아 있는 동안 바뀌지 않음)
+     */
+    static size_t index_of(const T* object) {
+        return reinterpret_cast<const Slot*>(object)->index;
+    }
+
+    /**
+     * 남아 있는 객체를 모두 정리 (chunk 메모리는 다음 사용을 위해 유지)
+     */
+    void reset() {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < used && live_count > 0; i++) {
+                Slot& slot = slot_at(i);
+                if (!slot.live) continue;
+                reinterpret_cast<T*>(slot.storage)->~T();
+                slot.live = false;
+                live_count--;
+            }
+        }
+        free_slots.clear();
+        used = 0;
+        live_count = 0;
+    }
+
+    size_t size() const { return live_count; }
+};
+
+#endif //HW3_POOL_HPP
@@ -0,0 +1,133 @@
+#include "Program.hpp"
+#include "System.hpp"
+#include <fstream>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+
+/**
+ * 정수 operand 파싱
+ * @param str operand 문자열
+ * @param value 파싱 결과
+ * @return 파싱 성공 여부
+ */
+static bool parse_operand(const std::string& str, int& value) {
+    const char* begin = str.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(begin, &end, 10);
+    if (end == begin || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+const std::string& ProgramImage::line_at(int line) const {
+    static const std::string empty_line;
+
+    if (line < 1 || line > static_cast<int>(this->lines.size())) {
+        return empty_line;
+    }
+    return this->lines[line - 1];
+}
+
+Instruction ProgramImage::instruction_at(int line) const {
+    if (line < 1 || line > static_cast<int>(this->code.size())) {
+        return {Op_invalid, 0};
+    }
+    return this->code[line - 1];
+}
+
+Instruction ProgramCache::decode(const std::string& line) {
+    // 명령어와 인자는 공백 하나로 구분
+    size_t command_end = line.find(' ');
+    std::string command = line.substr(0, command_end);
+    std::string argument;
+    if (command_end != std::string::npos) {
+        size_t argument_end = line.find(' ', command_end + 1);
+        argument = line.substr(command_end + 1, argument_end == std::string::npos
+                                                ? std::string::npos
+                                                : argument_end - command_end - 1);
+    }
+
+    Instruction instruction{Op_invalid, 0};
+    if (command == RUN_COMMAND_STRING) {
+        instruction.op = Op_run;
+    } else if (command == MEMORY_READ_COMMAND_STRING) {
+        instruction.op = Op_memory_read;
+    } else if (command == MEMORY_WRITE_COMMAND_STRING) {
+        instruction.op = Op_memory_write;
+    } else if (command == SLEEP_COMMAND_STRING) {
+        instruction.op = Op_sleep;
+    } else if (command == WAIT_COMMAND_STRING) {
+        instruction.op = Op_wait;
+        return instruction;
+    } else if (command == EXIT_COMMAND_STRING) {
+        instruction.op = Op_exit;
+        return instruction;
+    } else if (command == FORK_AND_EXEC_COMMAND_STRING) {
+        instruction.op = Op_fork_and_exec;
+        instruction.operand = this->intern(argument);
+        return instruction;
+    } else if (command == MEMORY_ALLOCATE_COMMAND_STRING) {
+        instruction.op = Op_memory_allocate;
+    } else if (command == MEMORY_RELEASE_COMMAND_STRING) {
+        instruction.op = Op_memory_release;
+    } else {
+        return instruction;
+    }
+
+    // 숫자 인자가 필요한 명령어
+    if (!parse_operand(argument, instruction.operand)) {
+        instruction.op = Op_invalid;
+        instruction.operand = 0;
+    }
+    return instruction;
+}
+
+void ProgramCache::reset(const std::string& program_directory) {
+    this->directory = program_directory;
+    this->names.clear();
+    this->images.clear();
+    this->ids.clear();
+}
+
+int ProgramCache::intern(const std::string& name) {
+    auto it = this->ids.find(name);
+    if (it != this->ids.end()) {
+        return it->second;
+    }
+
+    int program_id = static_cast<int>(this->names.size());
+    this->names.push_back(name);
+    this->images.emplace_back(nullptr);
+    this->ids.emplace(name, program_id);
+    return program_id;
+}
+
+const ProgramImage* ProgramCache::load(int program_id) {
+    auto& slot = this->images[program_id];
+    if (slot != nullptr) {
+        return slot.get();
+    }
+
+    auto image = std::make_unique<ProgramImage>();
+    image->name = this->names[program_id];
+
+    // 파일이 없으면 빈 이미지 (모든 줄이 빈 명령어)
+    std::ifstream program(this->directory + image->name);
+    std::string line;
+    while (std::getline(program, line)) {
+        image->code.push_back(this->decode(line));
+        image->lines.push_back(std::move(line));
+    }
+
+    // decode 중 intern으로 images가 재할당될 수 있으므로 다시 인덱싱
+    this->images[program_id] = std::move(image);
+    return this->images[program_id].get();
+}
+
+const ProgramImage* ProgramCache::load(const std::string& name) {
+    return this->load(this->intern(name));
+}
@@ -0,0 +1,98 @@
+#ifndef HW3_PROGRAM_HPP
+#define HW3_PROGRAM_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+enum opcode {
+    Op_run,
+    Op_memory_read,
+    Op_memory_write,
+    Op_sleep,
+    Op_wait,
+    Op_exit,
+    Op_fork_and_exec,
+    Op_memory_allocate,
+    Op_memory_release,
+    Op_invalid, // 알 수 없는 명령어 또는 파일 끝
+};
+
+/**
+ * 디코딩된 명령어 한 줄\n
+ * operand는 명령어에 따라 cycle 수, page id, allocation id, 또는 프로그램 id(fork_and_exec)
+ */
+struct Instruction {
+    opcode op;
+    int operand;
+};
+
+/**
+ * 한 번 읽어 들인 프로그램 파일\n
+ * 명령어 한 줄이 하나의 원소이며 current_line - 1 번째 원소가 다음에 실행할 명령어
+ */
+struct ProgramImage {
+    std::string name;
+    std::vector<std::string> lines; // 출력용 원본 명령어
+    std::vector<Instruction> code; // lines와 같은 인덱스의 디코딩된 명령어
+
+    /**
+     * 줄 번호(1부터 시작)로 명령어 원문 조회
+     * @param line 줄 번호
+     * @return 명령어, 파일 끝을 넘어가면 빈 문자열
+     */
+    const std::string& line_at(int line) const;
+
+    /**
+     * 줄 번호(1부터 시작)로 디코딩된 명령어 조회
+     * @param line 줄 번호
+     * @return 명령어, 파일 끝을 넘어가면 Op_invalid
+     */
+    Instruction instruction_at(int line) const;
+};
+
+/**
+ * 프로그램 이미지 캐시\n
+ * 프로그램 파일은 처음 fork_and_exec(또는 boot) 될 때 한 번만 읽고 디코딩하며,
+ * 같은 프로그램을 실행하는 모든 프로세스가 이미지를 공유한다.
+ */
+class ProgramCache {
+private:
+    std::string directory;
+    std::vector<std::string> names; // 프로그램 id -> 이름
+    std::vector<std::unique_ptr<ProgramImage>> images; // 프로그램 id -> 이미지 (읽기 전에는 nullptr)
+    std::unordered_map<std::string, int> ids;
+
+    /**
+     * 명령어 한 줄 디코딩
+     * @param line 명령어 원문
+     * @return 디코딩된 명령어
+     */
+    Instruction decode(const std::string& line);
+
+public:
+    /**
+     * 캐시를 비우고 프로그램을 읽어 올 디렉토리를 설정
+     * @param program_directory 프로그램 파일들이 있는 디렉토리 ('/'로 끝나야 함)
+     */
+    void reset(const std::string& program_directory);
+
+    /**
+     * 프로그램 이름에 id 부여 (파일은 읽지 않음)
+     * @param name 프로그램 이름
+     * @return 프로그램 id
+     */
+    int intern(const std::string& name);
+
+    /**
+     * 프로그램 이미지 조회, 아직 읽지 않았으면 파일에서 읽고 디코딩해서 캐시에 저장
+     * @param program_id 프로그램 id
+     * @return 프로그램 이미지 (캐시가 reset 되기 전까지 유효)
+     */
+    const ProgramImage* load(int program_id);
+
+    const ProgramImage* load(const std::string& name);
+};
+
+#endif //HW3_PROGRAM_HPP
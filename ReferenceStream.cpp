@@ -0,0 +1,116 @@
+#include "ReferenceStream.hpp"
+#include "Replacement.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+bool ReferenceRecorder::open(const std::string& filename) {
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == nullptr) {
+        fprintf(stderr, "cannot open %s\n", filename.c_str());
+        return false;
+    }
+    this->out.open(file);
+    this->out.write(REFERENCE_STREAM_MAGIC, sizeof(REFERENCE_STREAM_MAGIC));
+    this->recording = true;
+    return true;
+}
+
+void ReferenceRecorder::close() {
+    if (!this->recording) return;
+    this->out.close();
+    this->recording = false;
+}
+
+ReferenceIndex::~ReferenceIndex() {
+    if (this->next_use_file != nullptr) fclose(this->next_use_file);
+}
+
+bool ReferenceIndex::build(const std::string& filename) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "cannot open %s\n", filename.c_str());
+        return false;
+    }
+
+    char magic[sizeof(REFERENCE_STREAM_MAGIC)];
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic)
+        || memcmp(magic, REFERENCE_STREAM_MAGIC, sizeof(magic)) != 0) {
+        fprintf(stderr, "%s is not a reference stream\n", filename.c_str());
+        fclose(file);
+        return false;
+    }
+    const long entry_size = 2 * sizeof(int32_t);
+    fseek(file, 0, SEEK_END);
+    this->length = static_cast<int>((ftell(file) - (long) sizeof(magic)) / entry_size);
+
+    // 닫으면 사라지는 임시 파일
+    this->next_use_file = tmpfile();
+    if (this->next_use_file == nullptr) {
+        fprintf(stderr, "cannot create next-use file\n");
+        fclose(file);
+        return false;
+    }
+
+    // 뒤쪽 블록부터 읽으며 키마다 가장 가까운 뒤쪽 참조 위치를 들고 간다
+    std::unordered_map<long long, int> following;
+    std::vector<int32_t> entries(2 * BLOCK_SIZE);
+    std::vector<int32_t> next_uses(BLOCK_SIZE);
+    for (int end = this->length; end > 0;) {
+        int begin = std::max(0, end - BLOCK_SIZE);
+        int count = end - begin;
+        fseek(file, (long) sizeof(magic) + begin * entry_size, SEEK_SET);
+        if (fread(entries.data(), entry_size, count, file) != (size_t) count) {
+            fprintf(stderr, "%s is truncated\n", filename.c_str());
+            fclose(file);
+            return false;
+        }
+        for (int i = count - 1; i >= 0; i--) {
+            long long key = page_key(entries[2 * i], entries[2 * i + 1]);
+            auto found = following.find(key);
+            if (found == following.end()) {
+                next_uses[i] = NEVER;
+                following.emplace(key, begin + i);
+            } else {
+                next_uses[i] = found->second;
+                found->second = begin + i;
+            }
+        }
+        fseek(this->next_use_file, begin * (long) sizeof(int32_t), SEEK_SET);
+        fwrite(next_uses.data(), sizeof(int32_t), count, this->next_use_file);
+        end = begin;
+    }
+    fclose(file);
+
+    // 스트림 맨 앞까지 왔으므로 키마다 남은 위치가 첫 참조
+    this->first_use = std::move(following);
+    this->cache.assign(CACHE_SLOTS, CacheSlot());
+    return true;
+}
+
+int ReferenceIndex::take_first_use(long long key) {
+    auto found = this->first_use.find(key);
+    if (found == this->first_use.end()) return NEVER;
+    int position = found->second;
+    this->first_use.erase(found);
+    return position;
+}
+
+int ReferenceIndex::next_use(int position) {
+    if (position == NEVER || position >= this->length) return NEVER;
+    // 키마다 지금 참조 위치는 실행 진행과 함께 앞으로 가므로 읽는 블록이 몇 개에 몰린다
+    int block = position / BLOCK_SIZE;
+    CacheSlot& slot = this->cache[block % CACHE_SLOTS];
+    if (slot.block != block) {
+        int begin = block * BLOCK_SIZE;
+        int count = std::min(BLOCK_SIZE, this->length - begin);
+        slot.values.resize(count);
+        fseek(this->next_use_file, begin * (long) sizeof(int32_t), SEEK_SET);
+        if (fread(slot.values.data(), sizeof(int32_t), count, this->next_use_file) != (size_t) count) {
+            fprintf(stderr, "cannot read next-use file\n");
+            exit(1);
+        }
+        slot.block = block;
+    }
+    return slot.values[position % BLOCK_SIZE];
+}
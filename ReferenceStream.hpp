@@ -0,0 +1,107 @@
+#ifndef HW3_REFERENCE_STREAM_HPP
+#define HW3_REFERENCE_STREAM_HPP
+
+#include "Trace.hpp"
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// 참조 스트림 파일 맨 앞의 식별자
+const char REFERENCE_STREAM_MAGIC[8] = {'P', '3', 'R', 'E', 'F', 'S', 'T', '2'};
+
+/**
+ * OPT 사전 실행에서 프레임 참조 스트림을 파일에 기록\n
+ * 파일 형식: REFERENCE_STREAM_MAGIC 뒤에 참조마다 프레임의 pid, page id (int32 고정 길이)\n
+ * 참조는 프레임이 물리 메모리에 배치되거나(폴트, 할당, 복사) memory_read/memory_write로 접근된 것이다.
+ * 버퍼가 찰 때마다 파일에 쓰므로 실행이 길어져도 메모리에 쌓이지 않는다.
+ * 레코드 길이가 고정이라 ReferenceIndex가 뒤에서부터 블록 단위로 읽을 수 있다.
+ */
+class ReferenceRecorder {
+private:
+    TraceWriter out;
+    bool recording = false;
+
+public:
+    /**
+     * 기록 파일을 열고 헤더를 쓴다
+     * @param filename 참조 스트림 파일 이름
+     * @return 파일을 열었는지
+     */
+    bool open(const std::string& filename);
+
+    void record(int process_id, int page_id) {
+        int32_t entry[2] = {process_id, page_id};
+        out.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+    }
+
+    /**
+     * 남은 버퍼를 쓰고 파일을 닫는다
+     */
+    void close();
+};
+
+/**
+ * 참조 스트림의 다음 참조 색인\n
+ * build()가 스트림을 뒤에서부터 블록 단위로 읽으며(reverse pass) 위치마다 같은 키의 다음 참조 위치를
+ * 이름 없는 임시 파일(next-use 파일)에 쓴다. 메모리에는 키마다 첫 참조 위치 하나만 남고,
+ * next-use 파일은 작은 블록 캐시를 통해 읽으므로 메모리 사용량은 참조 수가 아니라 키 수에 비례한다.\n
+ * 다시 실행할 때 프로세스가 번갈아 실행되는 순서는 폴트 처리 cycle만큼 달라지므로 전역 순번으로 맞추지 않고,
+ * 같은 키의 k번째 참조끼리 대응시킨다: 사용하는 쪽이 키마다 지금 참조의 위치를 들고 있다가
+ * next_use()로 next-use 사슬을 한 칸씩 따라간다.
+ */
+class ReferenceIndex {
+private:
+    // next-use 파일을 읽는 단위 (위치 수)
+    static constexpr int BLOCK_SIZE = 1 << 14;
+    // 블록 캐시 칸 수 (direct-mapped)
+    static constexpr int CACHE_SLOTS = 8;
+
+    struct CacheSlot {
+        int block = -1;
+        std::vector<int32_t> values;
+    };
+
+    FILE* next_use_file = nullptr;
+    std::unordered_map<long long, int> first_use;
+    std::vector<CacheSlot> cache;
+    int length = 0;
+
+public:
+    // 다시 참조되지 않는 프레임의 다음 참조 위치
+    static const int NEVER = INT_MAX;
+
+    ReferenceIndex() = default;
+    ReferenceIndex(const ReferenceIndex&) = delete;
+    ReferenceIndex& operator=(const ReferenceIndex&) = delete;
+    ~ReferenceIndex();
+
+    /**
+     * 참조 스트림 파일을 뒤에서부터 읽어 next-use 파일 생성
+     * @param filename 참조 스트림 파일 이름
+     * @return 색인을 만들었는지
+     */
+    bool build(const std::string& filename);
+
+    /**
+     * 키의 첫 참조 위치를 꺼낸다 (키마다 한 번만 호출되므로 꺼낸 항목은 지움)
+     * @param key 프레임의 page_key
+     * @return 첫 참조 위치, 기록되지 않은 키면 NEVER
+     */
+    int take_first_use(long long key);
+
+    /**
+     * @param position 참조 위치
+     * @return 그 위치와 같은 키의 다음 참조 위치, 없으면 NEVER
+     */
+    int next_use(int position);
+
+    /**
+     * @return 기록된 참조 수
+     */
+    int size() const { return length; }
+};
+
+#endif //HW3_REFERENCE_STREAM_HPP
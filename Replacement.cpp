@@ -0,0 +1,462 @@
+#include "Replacement.hpp"
+#include "System.hpp"
+#include "ReferenceStream.hpp"
+#include <algorithm>
+
+void FrameQueue::push_back(int address) {
+    prev[address] = tail;
+    next[address] = -1;
+    if (tail == -1) {
+        head = address;
+    } else {
+        next[tail] = address;
+    }
+    tail = address;
+}
+
+void FrameQueue::remove(int address) {
+    if (prev[address] == -1) {
+        head = next[address];
+    } else {
+        next[prev[address]] = next[address];
+    }
+    if (next[address] == -1) {
+        tail = prev[address];
+    } else {
+        prev[next[address]] = prev[address];
+    }
+    prev[address] = -1;
+    next[address] = -1;
+}
+
+void FrequencyReplacer::inserted(int address, const FrameTable& frames) {
+    auto it = buckets.try_emplace(frames.fu_score[address]).first;
+    it->second.insert(address);
+    bucket_of[address] = it;
+}
+
+void FrequencyReplacer::accessed(int address) {
+    auto current = bucket_of[address];
+    // 접근 횟수 + 1인 bucket은 있다면 바로 다음 bucket이므로 그 위치를 hint로 삽입 (상수 시간)
+    auto next = buckets.emplace_hint(std::next(current), current->first + 1, std::set<int>());
+    next->second.insert(address);
+    bucket_of[address] = next;
+
+    current->second.erase(address);
+    if (current->second.empty()) buckets.erase(current);
+}
+
+void FrequencyReplacer::removed(int address) {
+    auto current = bucket_of[address];
+    current->second.erase(address);
+    if (current->second.empty()) buckets.erase(current);
+    bucket_of[address] = buckets.end();
+}
+
+int FrequencyReplacer::victim(FrameTable& frames) {
+    if (buckets.empty()) return -1;
+    const std::set<int>& bucket = most_frequent ? buckets.rbegin()->second : buckets.begin()->second;
+    return *bucket.begin();
+}
+
+int ClockReplacer::victim(FrameTable& frames) {
+    if (resident_count == 0) return -1;
+    while (true) {
+        int address = hand;
+        hand = (hand + 1) % frame_count;
+        if (!frames.is_occupied(address)) continue;
+        if (!frames.referenced[address]) return address;
+        frames.referenced[address] = 0;
+    }
+}
+
+int SecondChanceReplacer::victim(FrameTable& frames) {
+    while (true) {
+        int address = queue.front();
+        if (address == -1 || !frames.referenced[address]) return address;
+        frames.referenced[address] = 0;
+        queue.move_to_back(address);
+    }
+}
+
+ClockProReplacer::ClockProReplacer(int frame_count)
+        : frame_count(frame_count), cold_target(1), entry_of(frame_count, clock.end()) {
+    hand_hot = clock.end();
+    hand_cold = clock.end();
+    hand_test = clock.end();
+}
+
+void ClockProReplacer::advance(iterator& hand) {
+    ++hand;
+    if (hand == clock.end()) hand = clock.begin();
+}
+
+void ClockProReplacer::step_hands_off(iterator entry) {
+    for (iterator* hand: {&hand_hot, &hand_cold, &hand_test}) {
+        if (*hand == entry) advance(*hand);
+    }
+}
+
+void ClockProReplacer::erase(iterator entry) {
+    step_hands_off(entry);
+    clock.erase(entry);
+    if (clock.empty()) {
+        hand_hot = clock.end();
+        hand_cold = clock.end();
+        hand_test = clock.end();
+    }
+}
+
+void ClockProReplacer::move_to_head(iterator entry) {
+    step_hands_off(entry);
+    clock.splice(hand_hot, clock, entry);
+}
+
+ClockProReplacer::iterator ClockProReplacer::insert_at_head(const Entry& entry) {
+    if (clock.empty()) {
+        clock.push_back(entry);
+        hand_hot = clock.begin();
+        hand_cold = clock.begin();
+        hand_test = clock.begin();
+        return clock.begin();
+    }
+    return clock.insert(hand_hot, entry);
+}
+
+void ClockProReplacer::end_test(Entry& entry) {
+    entry.test = false;
+    cold_target = std::max(cold_target - 1, 1);
+}
+
+void ClockProReplacer::run_hand_hot(FrameTable& frames) {
+    // 참조 비트가 0인 hot 프레임 하나를 cold로 강등할 때까지 진행
+    while (true) {
+        iterator current = hand_hot;
+        Entry& entry = *current;
+        if (entry.hot) {
+            if (!frames.referenced[entry.address]) {
+                entry.hot = false;
+                hot_count--;
+                cold_count++;
+                advance(hand_hot);
+                return;
+            }
+            frames.referenced[entry.address] = 0;
+            advance(hand_hot);
+        } else if (entry.address == -1) {
+            end_test(entry);
+            non_resident.erase(entry.key);
+            erase(current);
+        } else {
+            if (entry.test) end_test(entry);
+            advance(hand_hot);
+        }
+    }
+}
+
+void ClockProReplacer::run_hand_test() {
+    // non-resident 페이지가 프레임 수 이하가 될 때까지 가장 오래된 것부터 제거
+    while ((int) non_resident.size() > frame_count) {
+        iterator current = hand_test;
+        Entry& entry = *current;
+        if (entry.address == -1) {
+            end_test(entry);
+            non_resident.erase(entry.key);
+            erase(current);
+        } else {
+            if (!entry.hot && entry.test) end_test(entry);
+            advance(hand_test);
+        }
+    }
+}
+
+void ClockProReplacer::inserted(int address, const FrameTable& frames) {
+    long long key = page_key(frames.process_id[address], frames.page_id[address]);
+    auto found = non_resident.find(key);
+    if (found != non_resident.end()) {
+        // 테스트 기간 중에 교체된 페이지가 다시 참조됨 -> hot으로 들어오고 cold 프레임 목표 수 증가
+        iterator entry = found->second;
+        non_resident.erase(found);
+        entry->address = address;
+        entry->hot = true;
+        entry->test = false;
+        hot_count++;
+        cold_target = std::min(cold_target + 1, std::max(1, frame_count - 1));
+        move_to_head(entry);
+        entry_of[address] = entry;
+        return;
+    }
+    entry_of[address] = insert_at_head(Entry{key, address, false, true});
+    cold_count++;
+}
+
+void ClockProReplacer::removed(int address) {
+    iterator entry = entry_of[address];
+    entry_of[address] = clock.end();
+    if (entry->hot) {
+        hot_count--;
+    } else {
+        cold_count--;
+    }
+
+    if (address == victim_address) {
+        victim_address = -1;
+        if (entry->test) {
+            // 테스트 기간 중에 교체된 cold 페이지는 non-resident로 남김
+            entry->address = -1;
+            non_resident[entry->key] = entry;
+            run_hand_test();
+            return;
+        }
+    }
+    erase(entry);
+}
+
+int ClockProReplacer::victim(FrameTable& frames) {
+    if (hot_count + cold_count == 0) return -1;
+    while (true) {
+        // hot 프레임이 목표 수를 넘거나 cold 프레임이 없으면 hot 프레임을 cold로 강등
+        while (hot_count > 0 && (cold_count == 0 || hot_count > frame_count - cold_target)) {
+            run_hand_hot(frames);
+        }
+
+        iterator current = hand_cold;
+        Entry& entry = *current;
+        if (entry.hot || entry.address == -1) {
+            advance(hand_cold);
+            continue;
+        }
+        if (!frames.referenced[entry.address]) {
+            victim_address = entry.address;
+            advance(hand_cold);
+            return victim_address;
+        }
+
+        frames.referenced[entry.address] = 0;
+        if (entry.test) {
+            // 테스트 기간 중에 다시 참조됨 -> hot으로 승격
+            entry.hot = true;
+            entry.test = false;
+            cold_count--;
+            hot_count++;
+            cold_target = std::min(cold_target + 1, std::max(1, frame_count - 1));
+        } else {
+            entry.test = true;
+        }
+        move_to_head(current);
+    }
+}
+
+void ArcReplacer::faulted(long long key) {
+    faulted_key = key;
+    // ghost list에 있으면 그 리스트가 작았던 것이므로 목표 크기 조절
+    if (recent_ghost.contains(key)) {
+        int delta = std::max(frequent_ghost.size() / recent_ghost.size(), 1);
+        recent_target = std::min(recent_target + delta, frame_count);
+    } else if (frequent_ghost.contains(key)) {
+        int delta = std::max(recent_ghost.size() / frequent_ghost.size(), 1);
+        recent_target = std::max(recent_target - delta, 0);
+    }
+}
+
+void ArcReplacer::inserted(int address, const FrameTable& frames) {
+    long long key = page_key(frames.process_id[address], frames.page_id[address]);
+    key_of[address] = key;
+    faulted_key = -1;
+
+    if (recent_ghost.remove(key) || frequent_ghost.remove(key)) {
+        frequent.push_back(address);
+        list_of[address] = Frequent_list;
+        frequent_count++;
+        return;
+    }
+
+    // 새 페이지: ghost list 크기 유지 (|T1| + |B1| < c, 전체 < 2c가 된 뒤 T1에 추가)
+    while (recent_count + recent_ghost.size() >= frame_count && !recent_ghost.empty()) {
+        recent_ghost.pop_front();
+    }
+    while (recent_count + frequent_count + recent_ghost.size() + frequent_ghost.size() >= 2 * frame_count) {
+        if (!frequent_ghost.empty()) {
+            frequent_ghost.pop_front();
+        } else if (!recent_ghost.empty()) {
+            recent_ghost.pop_front();
+        } else {
+            break;
+        }
+    }
+    recent.push_back(address);
+    list_of[address] = Recent_list;
+    recent_count++;
+}
+
+void ArcReplacer::accessed(int address) {
+    if (list_of[address] == Recent_list) {
+        recent.remove(address);
+        recent_count--;
+        frequent.push_back(address);
+        list_of[address] = Frequent_list;
+        frequent_count++;
+    } else {
+        frequent.move_to_back(address);
+    }
+}
+
+void ArcReplacer::removed(int address) {
+    resident_list list = list_of[address];
+    list_of[address] = No_list;
+    if (list == Recent_list) {
+        recent.remove(address);
+        recent_count--;
+    } else {
+        frequent.remove(address);
+        frequent_count--;
+    }
+
+    // 교체된 페이지만 기록 (해제된 페이지는 다시 폴트 나지 않음)
+    if (address == victim_address) {
+        victim_address = -1;
+        (list == Recent_list ? recent_ghost : frequent_ghost).push_back(key_of[address]);
+    }
+}
+
+int ArcReplacer::victim(FrameTable& frames) {
+    if (recent_count + frequent_count == 0) return -1;
+    bool in_frequent_ghost = faulted_key != -1 && frequent_ghost.contains(faulted_key);
+    if (recent_count > 0
+        && (recent_count > recent_target || (in_frequent_ghost && recent_count == recent_target) || frequent_count == 0)) {
+        victim_address = recent.front();
+    } else {
+        victim_address = frequent.front();
+    }
+    return victim_address;
+}
+
+void TwoQueueReplacer::inserted(int address, const FrameTable& frames) {
+    long long key = page_key(frames.process_id[address], frames.page_id[address]);
+    key_of[address] = key;
+    if (recent_ghost.remove(key)) {
+        frequent.push_back(address);
+        list_of[address] = Frequent_list;
+        frequent_count++;
+    } else {
+        recent.push_back(address);
+        list_of[address] = Recent_list;
+        recent_count++;
+    }
+}
+
+void TwoQueueReplacer::accessed(int address) {
+    // A1in 안에서의 접근은 순서를 바꾸지 않음 (짧은 시간 안의 재참조는 한 번으로 취급)
+    if (list_of[address] == Frequent_list) frequent.move_to_back(address);
+}
+
+void TwoQueueReplacer::removed(int address) {
+    resident_list list = list_of[address];
+    list_of[address] = No_list;
+    if (list == Recent_list) {
+        recent.remove(address);
+        recent_count--;
+    } else {
+        frequent.remove(address);
+        frequent_count--;
+    }
+
+    // A1in에서 교체된 페이지만 A1out에 기록
+    if (address == victim_address) {
+        victim_address = -1;
+        if (list == Recent_list) {
+            recent_ghost.push_back(key_of[address]);
+            if (recent_ghost.size() > ghost_capacity) recent_ghost.pop_front();
+        }
+    }
+}
+
+int TwoQueueReplacer::victim(FrameTable& frames) {
+    if (recent_count + frequent_count == 0) return -1;
+    if (recent_count > recent_capacity || frequent_count == 0) {
+        victim_address = recent.front();
+    } else {
+        victim_address = frequent.front();
+    }
+    return victim_address;
+}
+
+void OptReplacer::referenced(int address) {
+    long long key = key_of[address];
+    int next_use = ReferenceIndex::NEVER;
+    if (future != nullptr) {
+        // 지금 참조에 대응하는 위치에서 next-use 사슬을 한 칸 따라간다
+        auto found = upcoming.find(key);
+        int position = found == upcoming.end() ? future->take_first_use(key) : found->second;
+        next_use = future->next_use(position);
+        upcoming[key] = next_use;
+    }
+    heap.push({next_use, address, ++version[address]});
+
+    // 무효 항목이 쌓이면 유효한 항목만으로 다시 구성
+    if ((int) heap.size() > 4 * frame_count + 64) {
+        std::vector<HeapEntry> valid;
+        while (!heap.empty()) {
+            if (heap.top().version == version[heap.top().address]) valid.push_back(heap.top());
+            heap.pop();
+        }
+        heap = std::priority_queue<HeapEntry>(std::less<HeapEntry>(), std::move(valid));
+    }
+}
+
+void OptReplacer::inserted(int address, const FrameTable& frames) {
+    key_of[address] = page_key(frames.process_id[address], frames.page_id[address]);
+    referenced(address);
+}
+
+void OptReplacer::accessed(int address) {
+    referenced(address);
+}
+
+void OptReplacer::removed(int address) {
+    version[address]++;
+}
+
+int OptReplacer::victim(FrameTable& frames) {
+    while (!heap.empty() && heap.top().version != version[heap.top().address]) heap.pop();
+    if (heap.empty()) return -1;
+    return heap.top().address;
+}
+
+void RecordingReplacer::inserted(int address, const FrameTable& frames) {
+    frame_of[address] = {frames.process_id[address], frames.page_id[address]};
+    recorder->record(frame_of[address].first, frame_of[address].second);
+    inner->inserted(address, frames);
+}
+
+void RecordingReplacer::accessed(int address) {
+    recorder->record(frame_of[address].first, frame_of[address].second);
+    inner->accessed(address);
+}
+
+std::unique_ptr<Replacer> make_replacer(page_replacement_policy policy, int frame_count,
+                                        std::shared_ptr<ReferenceIndex> future) {
+    switch (policy) {
+        case FIFO:
+            return std::make_unique<FifoReplacer>(frame_count);
+        case LRU:
+            return std::make_unique<LruReplacer>(frame_count);
+        case LFU:
+            return std::make_unique<FrequencyReplacer>(frame_count, false);
+        case MFU:
+            return std::make_unique<FrequencyReplacer>(frame_count, true);
+        case CLOCK:
+            return std::make_unique<ClockReplacer>(frame_count);
+        case SECOND_CHANCE:
+            return std::make_unique<SecondChanceReplacer>(frame_count);
+        case CLOCK_PRO:
+            return std::make_unique<ClockProReplacer>(frame_count);
+        case ARC:
+            return std::make_unique<ArcReplacer>(frame_count);
+        case TWO_Q:
+            return std::make_unique<TwoQueueReplacer>(frame_count);
+        case OPT:
+            return std::make_unique<OptReplacer>(frame_count, std::move(future));
+    }
+    return nullptr;
+}
@@ -0,0 +1,518 @@
+#ifndef HW3_REPLACEMENT_HPP
+#define HW3_REPLACEMENT_HPP
+
+#include <algorithm>
+#include <vector>
+#include <list>
+#include <set>
+#include <map>
+#include <queue>
+#include <memory>
+#include <unordered_map>
+
+struct FrameTable;
+class ReferenceIndex;
+class ReferenceRecorder;
+
+enum page_replacement_policy {
+    FIFO,
+    LRU,
+    MFU,
+    LFU,
+    CLOCK, // 물리 메모리 주소 순서로 도는 hand, 참조 비트가 있으면 지우고 지나감
+    SECOND_CHANCE, // FIFO 순서, 맨 앞 프레임의 참조 비트가 있으면 지우고 맨 뒤로 보냄
+    CLOCK_PRO, // hot/cold 프레임과 교체된 cold 페이지의 테스트 기간을 추적하는 CLOCK
+    ARC, // 한 번 접근된 프레임과 여러 번 접근된 프레임의 LRU 리스트 크기를 교체 기록(ghost)으로 조절
+    TWO_Q, // 처음 들어온 프레임은 FIFO에 두고, 그 FIFO에서 교체된 뒤 다시 폴트가 나면 LRU로 승격
+    OPT, // 사전 실행으로 기록한 참조 스트림에서 다음 참조가 가장 먼 프레임 (Belady)
+};
+
+/**
+ * 교체 기록에서 페이지를 구분하는 키
+ * @param process_id 프레임을 가진 프로세스 id
+ * @param page_id page id
+ */
+inline long long page_key(int process_id, int page_id) {
+    return ((long long) process_id << 32) | (unsigned int) page_id;
+}
+
+enum victim_search {
+    Indexed_victim_search, // 정책별 자료구조(Replacer)로 교체 대상 선택
+    Scan_victim_search, // 물리 메모리 전체를 선형 탐색
+};
+
+/**
+ * 교체 대상 프레임을 고르기 위한 정책별 자료구조\n
+ * 물리 메모리에 프레임이 들어오거나(inserted), 접근되거나(accessed), 나갈 때(removed) 갱신되며
+ * victim()은 Status::replace_page()의 선형 탐색과 같은 프레임(동점이면 가장 낮은 인덱스)을 돌려준다.
+ * CLOCK 계열은 victim()에서 hand를 옮기고 참조 비트를 지우므로 교체할 때 한 번만 호출해야 한다.
+ */
+class Replacer {
+public:
+    virtual ~Replacer() = default;
+
+    /**
+     * 페이지 폴트 발생 (page_fault_handler에서 교체와 배치 전에 호출, 교체 기록이 없는 정책은 무시)
+     * @param key 폴트가 난 페이지의 page_key
+     */
+    virtual void faulted(long long key) {}
+
+    /**
+     * 프레임이 물리 메모리에 배치됨 (점수가 이미 갱신된 상태)
+     * @param address 물리 메모리 주소
+     * @param frames 프레임이 배치된 프레임 테이블
+     */
+    virtual void inserted(int address, const FrameTable& frames) = 0;
+
+    /**
+     * memory_read/memory_write로 프레임이 접근됨
+     * @param address 물리 메모리 주소
+     */
+    virtual void accessed(int address) = 0;
+
+    /**
+     * 프레임이 물리 메모리에서 빠짐 (교체 또는 해제)
+     * @param address 물리 메모리 주소
+     */
+    virtual void removed(int address) = 0;
+
+    /**
+     * 교체 대상 선택 (바로 뒤에 그 프레임이 removed()로 빠짐)
+     * @param frames 프레임 테이블 (CLOCK 계열은 참조 비트를 지움)
+     * @return 교체되어야 할 물리 메모리 주소, 프레임이 없으면 -1
+     */
+    virtual int victim(FrameTable& frames) = 0;
+};
+
+/**
+ * 물리 메모리 주소를 노드로 사용하는 intrusive 이중 연결 리스트
+ */
+class FrameQueue {
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    int head = -1;
+    int tail = -1;
+
+public:
+    explicit FrameQueue(int frame_count) : prev(frame_count, -1), next(frame_count, -1) {}
+
+    void push_back(int address);
+
+    void remove(int address);
+
+    void move_to_back(int address) {
+        if (tail == address) return;
+        remove(address);
+        push_back(address);
+    }
+
+    int front() const {
+        return head;
+    }
+};
+
+/**
+ * 교체된 페이지의 page_key 기록 (ghost list)\n
+ * 앞이 가장 오래된 기록이며 조회, 삽입, 삭제가 모두 O(1)이다.
+ */
+class GhostList {
+private:
+    std::list<long long> keys;
+    std::unordered_map<long long, std::list<long long>::iterator> position;
+
+public:
+    bool contains(long long key) const {
+        return position.find(key) != position.end();
+    }
+
+    void push_back(long long key) {
+        if (contains(key)) return;
+        position[key] = keys.insert(keys.end(), key);
+    }
+
+    /**
+     * @return 기록에 있었는지
+     */
+    bool remove(long long key) {
+        auto found = position.find(key);
+        if (found == position.end()) return false;
+        keys.erase(found->second);
+        position.erase(found);
+        return true;
+    }
+
+    void pop_front() {
+        position.erase(keys.front());
+        keys.pop_front();
+    }
+
+    bool empty() const { return keys.empty(); }
+
+    int size() const { return (int) keys.size(); }
+};
+
+/**
+ * ARC, 2Q에서 물리 메모리 프레임이 속한 리스트
+ */
+enum resident_list {
+    No_list,
+    Recent_list, // ARC의 T1, 2Q의 A1in (한 번 폴트로 들어온 프레임)
+    Frequent_list, // ARC의 T2, 2Q의 Am (다시 참조된 프레임)
+};
+
+/**
+ * FIFO: 먼저 들어온 프레임이 리스트 앞 (fi_score 순서)
+ */
+class FifoReplacer : public Replacer {
+private:
+    FrameQueue queue;
+
+public:
+    explicit FifoReplacer(int frame_count) : queue(frame_count) {}
+
+    void inserted(int address, const FrameTable& frames) override {
+        queue.push_back(address);
+    }
+
+    void accessed(int address) override {}
+
+    void removed(int address) override {
+        queue.remove(address);
+    }
+
+    int victim(FrameTable& frames) override {
+        return queue.front();
+    }
+};
+
+/**
+ * LRU: 접근될 때마다 리스트 뒤로 이동 (ru_score 순서)
+ */
+class LruReplacer : public Replacer {
+private:
+    FrameQueue queue;
+
+public:
+    explicit LruReplacer(int frame_count) : queue(frame_count) {}
+
+    void inserted(int address, const FrameTable& frames) override {
+        queue.push_back(address);
+    }
+
+    void accessed(int address) override {
+        queue.move_to_back(address);
+    }
+
+    void removed(int address) override {
+        queue.remove(address);
+    }
+
+    int victim(FrameTable& frames) override {
+        return queue.front();
+    }
+};
+
+/**
+ * LFU/MFU: 접근 횟수(fu_score)별 bucket을 접근 횟수 순서의 map으로 관리\n
+ * 같은 bucket 안에서는 가장 낮은 주소가 교체 대상이어야 선형 탐색과 같은 프레임을 고르므로 bucket은 주소의 set이다.
+ * 접근은 바로 다음 bucket으로 옮기므로 bucket 찾기는 O(1), set 삽입이 O(log n)이다.
+ * 스왑에서 돌아온 프레임은 이전 접근 횟수를 유지하므로 배치할 때의 bucket은 map에서 O(log bucket 수)로 찾는다.
+ */
+class FrequencyReplacer : public Replacer {
+private:
+    using BucketMap = std::map<int, std::set<int>>;
+
+    bool most_frequent; // true면 MFU, false면 LFU
+    BucketMap buckets;
+    std::vector<BucketMap::iterator> bucket_of;
+
+public:
+    FrequencyReplacer(int frame_count, bool most_frequent)
+            : most_frequent(most_frequent), bucket_of(frame_count, buckets.end()) {}
+
+    void inserted(int address, const FrameTable& frames) override;
+
+    void accessed(int address) override;
+
+    void removed(int address) override;
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * CLOCK: 물리 메모리 주소를 원형으로 도는 hand\n
+ * 참조 비트가 1인 프레임은 비트를 지우고 지나가고, 0인 프레임을 교체한다. (hand는 교체한 프레임 다음에 멈춤)
+ */
+class ClockReplacer : public Replacer {
+private:
+    int frame_count;
+    int resident_count = 0;
+    int hand = 0;
+
+public:
+    explicit ClockReplacer(int frame_count) : frame_count(frame_count) {}
+
+    void inserted(int address, const FrameTable& frames) override {
+        resident_count++;
+    }
+
+    void accessed(int address) override {}
+
+    void removed(int address) override {
+        resident_count--;
+    }
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * Second chance: FIFO 리스트의 맨 앞 프레임이 참조 비트가 1이면 비트를 지우고 맨 뒤로 보낸다.
+ */
+class SecondChanceReplacer : public Replacer {
+private:
+    FrameQueue queue;
+
+public:
+    explicit SecondChanceReplacer(int frame_count) : queue(frame_count) {}
+
+    void inserted(int address, const FrameTable& frames) override {
+        queue.push_back(address);
+    }
+
+    void accessed(int address) override {}
+
+    void removed(int address) override {
+        queue.remove(address);
+    }
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * CLOCK-Pro (Jiang, Chen, Zhang, USENIX ATC 2005)\n
+ * 물리 메모리의 프레임(hot 또는 cold)과 테스트 기간 중에 교체된 cold 페이지(non-resident)를 원형 리스트 하나에 두고
+ * 세 hand로 관리한다. 새 페이지는 cold로 들어와 테스트 기간을 시작하며, 테스트 기간 중에 다시 참조되면 hot이 된다.
+ * - hand_cold: 참조 비트가 0인 cold 프레임을 교체, 1이면 (테스트 기간이면 hot으로 승격, 아니면 테스트 기간 시작)
+ * - hand_hot: hot 프레임 수가 목표를 넘으면 참조 비트가 0인 hot 프레임을 cold로 강등, 지나가는 테스트 기간을 끝냄
+ * - hand_test: non-resident 페이지가 프레임 수를 넘으면 가장 오래된 것부터 제거
+ * cold 프레임 목표 수는 테스트 기간 중 재참조되면 늘리고, 재참조 없이 테스트 기간이 끝나면 줄인다.
+ * 페이지는 (pid, page id)로 구분하며 교체되지 않고 해제된 페이지는 바로 리스트에서 뺀다.
+ */
+class ClockProReplacer : public Replacer {
+private:
+    struct Entry {
+        long long key; // (pid, page id)
+        int address; // 물리 메모리 주소, non-resident면 -1
+        bool hot;
+        bool test; // 테스트 기간 중인지 (cold만)
+    };
+    using iterator = std::list<Entry>::iterator;
+
+    int frame_count;
+    int cold_target;
+    int hot_count = 0;
+    int cold_count = 0;
+    std::list<Entry> clock;
+    iterator hand_hot;
+    iterator hand_cold;
+    iterator hand_test;
+    std::vector<iterator> entry_of; // 물리 메모리 주소 -> 항목
+    std::unordered_map<long long, iterator> non_resident; // (pid, page id) -> 교체된 cold 페이지 항목
+    // victim()이 고른 프레임 (removed()에서 해제와 교체를 구분)
+    int victim_address = -1;
+
+    void advance(iterator& hand);
+
+    /**
+     * 항목에 멈춰 있는 hand를 다음 항목으로 옮김 (항목을 옮기거나 지우기 전에 호출)
+     */
+    void step_hands_off(iterator entry);
+
+    void erase(iterator entry);
+
+    /**
+     * 리스트 head (hand_hot 바로 앞, 모든 hand가 가장 늦게 도달하는 위치)로 이동
+     */
+    void move_to_head(iterator entry);
+
+    iterator insert_at_head(const Entry& entry);
+
+    void run_hand_hot(FrameTable& frames);
+
+    void run_hand_test();
+
+    /**
+     * 재참조 없이 테스트 기간이 끝남 (cold 프레임 목표 수 감소)
+     */
+    void end_test(Entry& entry);
+
+public:
+    explicit ClockProReplacer(int frame_count);
+
+    void inserted(int address, const FrameTable& frames) override;
+
+    void accessed(int address) override {}
+
+    void removed(int address) override;
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * ARC (Megiddo, Modha, FAST 2003)\n
+ * 물리 메모리의 프레임을 한 번 들어온 프레임의 LRU 리스트 T1과 다시 참조된 프레임의 LRU 리스트 T2로 나누고,
+ * 각 리스트에서 교체된 페이지를 ghost list B1, B2에 기록한다. 폴트가 난 페이지가 B1에 있으면 T1의 목표 크기(p)를,
+ * B2에 있으면 T2 쪽을 늘린 뒤 T2로 들어온다. 한 번만 읽고 지나가는 순차 접근은 T1에서 교체되어 T2를 밀어내지 않는다.
+ * 교체는 폴트 전에 고르므로 ghost list는 배치할 때 |T1| + |B1| <= c, 전체 <= 2c가 되도록 오래된 기록부터 지운다.
+ */
+class ArcReplacer : public Replacer {
+private:
+    int frame_count;
+    int recent_target = 0; // T1의 목표 크기 p
+    FrameQueue recent; // T1
+    FrameQueue frequent; // T2
+    int recent_count = 0;
+    int frequent_count = 0;
+    std::vector<resident_list> list_of;
+    std::vector<long long> key_of;
+    GhostList recent_ghost; // B1
+    GhostList frequent_ghost; // B2
+    long long faulted_key = -1;
+    // victim()이 고른 프레임 (removed()에서 해제와 교체를 구분)
+    int victim_address = -1;
+
+public:
+    explicit ArcReplacer(int frame_count)
+            : frame_count(frame_count), recent(frame_count), frequent(frame_count), list_of(frame_count, No_list),
+              key_of(frame_count, -1) {}
+
+    void faulted(long long key) override;
+
+    void inserted(int address, const FrameTable& frames) override;
+
+    void accessed(int address) override;
+
+    void removed(int address) override;
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * 2Q (Johnson, Shasha, VLDB 1994)\n
+ * 처음 들어온 프레임은 FIFO A1in에 두고 A1in이 목표 크기(프레임의 1/4)를 넘으면 A1in에서 먼저 교체하며,
+ * A1in에서 교체된 페이지는 ghost list A1out(프레임의 1/2까지)에 기록한다. A1out에 있는 페이지가 다시 폴트 나면
+ * LRU 리스트 Am으로 들어가므로 한 번만 접근되는 페이지는 Am을 밀어내지 않는다.
+ */
+class TwoQueueReplacer : public Replacer {
+private:
+    int recent_capacity; // Kin
+    int ghost_capacity; // Kout
+    FrameQueue recent; // A1in
+    FrameQueue frequent; // Am
+    int recent_count = 0;
+    int frequent_count = 0;
+    std::vector<resident_list> list_of;
+    std::vector<long long> key_of;
+    GhostList recent_ghost; // A1out
+    int victim_address = -1;
+
+public:
+    explicit TwoQueueReplacer(int frame_count)
+            : recent_capacity(std::max(1, frame_count / 4)), ghost_capacity(std::max(1, frame_count / 2)),
+              recent(frame_count), frequent(frame_count), list_of(frame_count, No_list), key_of(frame_count, -1) {}
+
+    void inserted(int address, const FrameTable& frames) override;
+
+    void accessed(int address) override;
+
+    void removed(int address) override;
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * OPT (Belady)\n
+ * 사전 실행의 참조 스트림 색인(ReferenceIndex)으로 프레임마다 다음 참조 위치를 구하고,
+ * 다음 참조가 가장 먼 프레임을 max-heap에서 O(log n)에 꺼낸다 (동점이면 가장 낮은 주소).
+ * 프레임이 참조될 때마다 새 항목을 넣고 이전 항목은 버전으로 무효화하며, 무효 항목은 꺼낼 때 버린다.
+ */
+class OptReplacer : public Replacer {
+private:
+    struct HeapEntry {
+        int next_use;
+        int address;
+        int version;
+
+        bool operator<(const HeapEntry& other) const {
+            if (next_use != other.next_use) return next_use < other.next_use;
+            return address > other.address;
+        }
+    };
+
+    int frame_count;
+    std::shared_ptr<ReferenceIndex> future;
+    // 키별로 다음 참조가 사전 실행 스트림의 어느 위치에 대응하는지 (처음 참조되는 키는 없음)
+    std::unordered_map<long long, int> upcoming;
+    std::vector<long long> key_of;
+    std::vector<int> version;
+    std::priority_queue<HeapEntry> heap;
+
+    /**
+     * 프레임이 참조됨: 다음 참조 위치를 다시 구해 heap에 넣음
+     */
+    void referenced(int address);
+
+public:
+    /**
+     * @param frame_count 물리 메모리 프레임 수
+     * @param future 사전 실행의 참조 스트림 색인 (없으면 모든 프레임이 다시 참조되지 않는 것으로 봄)
+     */
+    OptReplacer(int frame_count, std::shared_ptr<ReferenceIndex> future)
+            : frame_count(frame_count), future(std::move(future)), key_of(frame_count, -1), version(frame_count, 0) {}
+
+    void inserted(int address, const FrameTable& frames) override;
+
+    void accessed(int address) override;
+
+    void removed(int address) override;
+
+    int victim(FrameTable& frames) override;
+};
+
+/**
+ * 다른 Replacer를 감싸 프레임 참조(배치, 접근)를 ReferenceRecorder에 기록 (OPT 사전 실행)\n
+ * 교체 대상 선택은 감싼 Replacer가 한다.
+ */
+class RecordingReplacer : public Replacer {
+private:
+    std::unique_ptr<Replacer> inner;
+    ReferenceRecorder* recorder;
+    // 주소별 프레임 (pid, page id), accessed()는 주소만 받으므로 배치될 때 저장
+    std::vector<std::pair<int, int>> frame_of;
+
+public:
+    RecordingReplacer(std::unique_ptr<Replacer> inner, ReferenceRecorder* recorder, int frame_count)
+            : inner(std::move(inner)), recorder(recorder), frame_of(frame_count, {-1, -1}) {}
+
+    void faulted(long long key) override { inner->faulted(key); }
+
+    void inserted(int address, const FrameTable& frames) override;
+
+    void accessed(int address) override;
+
+    void removed(int address) override { inner->removed(address); }
+
+    int victim(FrameTable& frames) override { return inner->victim(frames); }
+};
+
+/**
+ * 정책에 맞는 Replacer 생성
+ * @param policy 페이지 교체 알고리즘
+ * @param frame_count 물리 메모리 프레임 수
+ * @param future OPT에서 사용할 참조 스트림 색인 (다른 정책은 무시)
+ */
+std::unique_ptr<Replacer> make_replacer(page_replacement_policy policy, int frame_count,
+                                        std::shared_ptr<ReferenceIndex> future = nullptr);
+
+#endif //HW3_REPLACEMENT_HPP
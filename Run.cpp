@@ -5,75 +5,44 @@
 #include "Run.hpp"
 #include "Syscall.hpp"
 #include "Fault.hpp"
-#include <fstream>
-#include <sstream>
-#include <algorithm>
-
-namespace Run {
-    // 결과 출력 파일 스트림
-    FILE *result_file;
-    // Global Status
-    Status status;
-    // Executing directory
-    std::string path;
-}
-
-using namespace Run;
+#include <atomic>
+#include <filesystem>
+#include <unistd.h>
 
 const bool OUTPUT_STDOUT = false;
 
-std::vector<std::string> split(const std::string &str, char delim) {
-    std::vector<std::string> result;
-    std::istringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delim)) {
-        result.push_back(token);
-    }
-    return result;
-}
-
-std::string run_program() {
-    std::ifstream program(path + status.process_running->name);
-    std::string command;
-
-    for (int i = 1; i < status.process_running->current_line; i++) {
-        std::string line;
-        getline(program, line);
-    }
-
-    std::getline(program, command);
-    program.close();
+Instruction run_program(Simulator &sim) {
+    Status &status = sim.status;
+    ScopedTimer timer(status.stats.timer(status.stats.run_program_timer));
+    Process *p = status.process_running;
+    status.command = &p->image->line_at(p->current_line);
+    Instruction instruction = p->image->instruction_at(p->current_line);
 
     // 다음 줄로 이동
-    status.process_running->current_line++;
-    return command;
+    p->current_line++;
+    return instruction;
 }
 
-void update() {
-
-    for (Process *p: status.process_waiting) {
-        // sleep 시간 갱신, 상태 갱신 (waiting -> ready)
-        if (p->remain_sleep_time > 0 && p->waiting_type == 'S') {
-            if (--(p->remain_sleep_time) == 0) {
-                p->state = Ready;
-            }
-        }
-    }
-
-    // Ready Queue 갱신 (waiting -> ready)
-    for (int i = 0; i < status.process_waiting.size(); i++) {
-        auto p = status.process_waiting[i];
-        if (p->state == Ready) {
-            status.process_ready.push_back(p);
-            p->waiting_type = '\0';
-        }
-    }
+/**
+ * sleep 시간 단위(tick)를 진행하며 sleep 시간이 끝난 프로세스 상태 갱신 및 Ready Queue 삽입 (waiting -> ready)\n
+ * 같은 tick에 깨어나는 프로세스는 waiting queue에 들어온 순서대로
+ * @param status status 변수
+ * @param ticks 진행할 tick 수
+ */
+static void advance_sleep_clock(Status &status, int ticks) {
+    status.tick += ticks;
+    status.process_sleeping.advance(status.tick, [&status](Process *p) {
+        status.process_waiting.remove(p);
+        p->state = Ready;
+        status.process_ready.push_back(p);
+        p->waiting_type = '\0';
+    });
+}
 
-    // Ready Queue에 들어간 프로세스들을 wating queue에서 제거
-    auto it = std::remove_if(status.process_waiting.begin(), status.process_waiting.end(),
-                             [](Process *p) { return p->state == Ready; });
-    status.process_waiting.erase(it, status.process_waiting.end());
+void update(Simulator &sim) {
+    Status &status = sim.status;
 
+    advance_sleep_clock(status, 1);
 
     // 상태 갱신 (new -> ready), Ready queue 삽입
     if (status.process_new != nullptr) {
@@ -84,266 +53,392 @@ void update() {
 
     // 상태 갱신 (terminated 삭제)
     if (status.process_terminated != nullptr) {
-        delete status.process_terminated;
+        status.process_pool.destroy(status.process_terminated);
         status.process_terminated = nullptr;
     }
 }
 
-void perform_cycle() {
-    update();
+/**
+ * update(), print_status()를 cycles번 반복한 것과 같은 상태로 한 번에 진행 (출력하지 않을 때만 사용)\n
+ * 첫 update()가 new, terminated 프로세스를 정리하고 나면 그 뒤로는 sleep 타이머 만료 외에 바뀌는 것이 없으므로
+ * 남은 tick은 타이머 휠에서 한 번에 진행한다.
+ * @param sim 실행 중인 시뮬레이터
+ * @param cycles 진행할 cycle 수
+ */
+static void skip_run_cycles(Simulator &sim, int cycles) {
+    Status &status = sim.status;
+    if (cycles <= 0) return;
+    update(sim);
+    advance_sleep_clock(status, cycles - 1);
+    status.cycle += cycles;
+}
+
+/**
+ * 현재 idle cycle 뒤로 이어지는 idle cycle을 건너뜀 (출력하지 않을 때만 사용)\n
+ * 실행할 프로세스는 sleep 중인 프로세스가 깨어나야만 생기므로, 가장 먼저 깨어나는 tick 직전까지의
+ * cycle은 모두 idle이다. 깨어나는 tick의 cycle은 건너뛰지 않고 평소처럼 실행한다.
+ * @param sim 실행 중인 시뮬레이터
+ */
+static void skip_idle_cycles(Simulator &sim) {
+    Status &status = sim.status;
+    if (status.process_sleeping.empty()) return;
+    int idle_cycles = (int) status.process_sleeping.next_deadline() - 1 - status.tick;
+    if (idle_cycles <= 0) return;
+    advance_sleep_clock(status, idle_cycles);
+    status.cycle += idle_cycles;
+}
+
+void perform_cycle(Simulator &sim) {
+    Status &status = sim.status;
+    update(sim);
 
     // 커널 모드 일때
     if (status.mode == KERNEL_MODE_STRING) {
-        if (status.command == SYSTEM_CALL_COMMAND_STRING) {
-            // 시스템 콜 수행
-            system_call();
-
-            // 상태 출력 후 모드 스위칭
-            print_status();
-            status.mode = KERNEL_MODE_STRING;
-            status.command = "";
-        } else if (status.command == FAULT_COMMAND_STRING) {
-            // 폴트 핸들러 수행
-            fault_handler();
+        switch (status.task) {
+            case System_call_task:
+                // 시스템 콜 수행
+                system_call(sim);
 
-            // 상태 출력 후 모드 스위칭
-            print_status();
-            status.mode = KERNEL_MODE_STRING;
-            status.command = "";
-        } else {
-            // 스케쥴 또는 idle 실행
-            schedule_or_idle();
+                // 상태 출력 후 모드 스위칭
+                print_status(sim);
+                status.mode = KERNEL_MODE_STRING;
+                status.command = &EMPTY_COMMAND_STRING;
+                status.task = No_kernel_task;
+                break;
+            case Fault_task:
+                // 폴트 핸들러 수행
+                fault_handler(sim);
 
-            // 상태 출력 후 모드 스위칭
-            print_status();
-            status.mode = USER_MODE_STRING;
+                // 상태 출력 후 모드 스위칭
+                print_status(sim);
+                status.mode = KERNEL_MODE_STRING;
+                status.command = &EMPTY_COMMAND_STRING;
+                status.task = No_kernel_task;
+                break;
+            default:
+                // 스케쥴 또는 idle 실행
+                schedule_or_idle(sim);
+
+                // 상태 출력 후 모드 스위칭 (idle이면 실행할 프로세스가 생길 때까지 커널 모드 유지)
+                print_status(sim);
+                if (status.process_running != nullptr) {
+                    status.mode = USER_MODE_STRING;
+                } else if (sim.output_mode == No_trace) {
+                    skip_idle_cycles(sim);
+                }
+                break;
         }
     } else {
         // 유저 모드일때
-        status.command = run_program();
-        auto command_vector = split(status.command);
-        std::string command = command_vector[0];
-        std::string argument;
-        if (command_vector.size() > 1) {
-            argument = command_vector[1];
-        }
+        Instruction instruction = run_program(sim);
 
-
-        if (command == RUN_COMMAND_STRING) {
+        if (instruction.op == Op_run) {
             // 명령어가 run인 경우
-            int arg_num = stoi(argument);
+            int arg_num = instruction.operand;
+            if (sim.output_mode == No_trace) {
+                skip_run_cycles(sim, arg_num);
+                return;
+            }
             for (int i = 0; i < arg_num; i++) {
-                update();
-                print_status();
+                update(sim);
+                print_status(sim);
                 status.cycle++;
             }
             return;
-        } else if (command == MEMORY_READ_COMMAND_STRING) {
+        } else if (instruction.op == Op_memory_read) {
             // 명령어가 memory_read인 경우
-            print_status();
+            print_status(sim);
             Process* p = status.process_running;
-            int page_id_to_read = stoi(argument);
-            int virtual_address = std::distance(p->virtual_memory.begin(),
-                                                std::find(p->virtual_memory.begin(),
-                                                          p->virtual_memory.end(),
-                                                          page_id_to_read));
+            int page_id_to_read = instruction.operand;
+            int virtual_address = p->virtual_address_of(page_id_to_read);
             auto& target_page_table_entry = p->page_table[virtual_address];
 
             if (target_page_table_entry->physical_address == -1) {
                 // 물리 메모리에 없다면 페이지 퐅트 핸들러 호출
-                status.command = FAULT_COMMAND_STRING;
+                status.command = &FAULT_COMMAND_STRING;
+                status.task = Fault_task;
                 status.mode = KERNEL_MODE_STRING;
                 status.fault_handler_type = Page_fault;
-                status.syscall_arg = argument;
+                status.syscall_arg = page_id_to_read;
             } else {
                 // ru(recently used), fu(frequently used) 점수 갱신
-                auto& target_frame = status.physical_memory[target_page_table_entry->physical_address];
-                target_frame->ru_score = status.top_ru_score++;
-                target_frame->fu_score++;
+                status.access_frame(target_page_table_entry->physical_address);
             }
 
-        } else if (command == MEMORY_WRITE_COMMAND_STRING) {
+        } else if (instruction.op == Op_memory_write) {
             // 명령어가 memory_write인 경우
-            print_status();
+            print_status(sim);
             Process* p = status.process_running;
-            int page_id_to_write = stoi(argument);
-            int virtual_address = std::distance(p->virtual_memory.begin(),
-                                                std::find(p->virtual_memory.begin(),
-                                              p->virtual_memory.end(),
-                                              page_id_to_write));
+            int page_id_to_write = instruction.operand;
+            int virtual_address = p->virtual_address_of(page_id_to_write);
             auto& target_page_table_entry = p->page_table[virtual_address];
 
             if (target_page_table_entry->authority == 'R') {
                 // 읽기 권한만 있을 때
-                status.command = FAULT_COMMAND_STRING;
+                status.command = &FAULT_COMMAND_STRING;
+                status.task = Fault_task;
                 status.mode = KERNEL_MODE_STRING;
                 status.fault_handler_type = Protection_fault;
-                status.syscall_arg = argument;
+                status.syscall_arg = page_id_to_write;
             } else {
                 // 쓰기 권한이 있을 때
                 if (target_page_table_entry->physical_address == -1) {
-                    status.command = FAULT_COMMAND_STRING;
+                    status.command = &FAULT_COMMAND_STRING;
+                status.task = Fault_task;
                     status.mode = KERNEL_MODE_STRING;
                     status.fault_handler_type = Page_fault;
-                    status.syscall_arg = argument;
+                    status.syscall_arg = page_id_to_write;
                 } else {
-                    auto& target_frame = status.physical_memory[target_page_table_entry->physical_address];
-                    target_frame->ru_score = status.top_ru_score++;
-                    target_frame->fu_score++;
+                    status.access_frame(target_page_table_entry->physical_address);
                 }
             }
         } else {
             // 시스템 콜을 호출하는 경우
-            print_status();
-            status.command = SYSTEM_CALL_COMMAND_STRING;
+            print_status(sim);
+            status.command = &SYSTEM_CALL_COMMAND_STRING;
+            status.task = System_call_task;
             status.mode = KERNEL_MODE_STRING;
-            status.syscall_type = string_to_system_call_type(command);
-            status.syscall_arg = argument;
+            status.syscall_type = opcode_to_system_call_type(instruction.op);
+            status.syscall_arg = instruction.operand;
+            status.process_running->syscall_cycle = status.cycle;
+            status.process_running->pending_syscall = status.syscall_type;
         }
     }
 
 
     // cycle +1
     status.cycle++;
-//    if (status.command == SYSTEM_CALL_COMMAND_STRING) {
-//        status.command = "";
-//    }
 }
 
-void run(const std::string &run_path, const std::string &replacement_policy, const std::string &result_filename) {
+/**
+ * OPT 사전 실행: 같은 워크로드를 LRU로 한 번 실행하며 참조 스트림을 임시 파일에 기록하고 다음 참조 색인 생성\n
+ * 임시 파일은 실행마다 이름이 달라 스윕에서 동시에 실행해도 겹치지 않으며, next-use 파일을 만든 뒤 지운다.
+ * @param run_path 프로그램 디렉토리
+ * @param search 교체 대상 선택 방식
+ * @param geometry 메모리 구성
+ * @return 참조 스트림 색인
+ */
+static std::shared_ptr<ReferenceIndex> record_future_references(const std::string &run_path,
+                                                                victim_search search,
+                                                                const MemoryGeometry &geometry) {
+    static std::atomic<int> next_stream_id{0};
+    std::string reference_filename = (std::filesystem::temp_directory_path()
+                                      / ("project3-" + std::to_string(getpid()) + "-"
+                                         + std::to_string(next_stream_id++) + ".refs")).string();
+
+    Simulator pre_pass;
+    pre_pass.reference_filename = reference_filename;
+    // 출력하지 않으므로 결과 파일 이름은 비워 둠 (참조 스트림 파일과 겹치지 않도록)
+    run(pre_pass, run_path, LRU_STRING, "", No_trace, search, geometry);
+
+    auto index = std::make_shared<ReferenceIndex>();
+    index->build(reference_filename);
+    std::error_code ignored;
+    std::filesystem::remove(reference_filename, ignored);
+    return index;
+}
+
+void run(Simulator &sim, const std::string &run_path, const std::string &replacement_policy,
+         const std::string &result_filename, trace_mode mode, victim_search search, const MemoryGeometry &geometry) {
+    Status &status = sim.status;
     status = Status();
     // 페이지 교체 알고리즘 설정
     status.replacement_policy = str_to_policy(replacement_policy);
-    Run::path = run_path;
-    result_file = OUTPUT_STDOUT ? stdout : fopen(result_filename.c_str(), "w");
+    status.victim_search_mode = search;
+    if (status.replacement_policy == OPT) {
+        status.future_references = record_future_references(run_path, search, geometry);
+    }
+    status.configure(geometry);
+    if (!sim.reference_filename.empty() && sim.references.open(sim.reference_filename)) {
+        status.replacer = std::make_unique<RecordingReplacer>(std::move(status.replacer), &sim.references,
+                                                              status.geometry.physical_memory_size);
+    }
+    status.stats.timers_enabled = sim.timers_enabled;
+    sim.path = run_path;
+    sim.programs.reset(run_path);
+    sim.output_mode = mode;
+    if (sim.output_mode != No_trace) {
+        sim.trace.open(OUTPUT_STDOUT && sim.output_mode == Text_trace ? stdout : fopen(result_filename.c_str(), "wb"));
+    }
+    if (sim.output_mode == Binary_trace) {
+        sim.binary_trace.open(&sim.trace, status.geometry);
+    }
 
     status.mode = KERNEL_MODE_STRING;
 
     // Boot 호출 (cycle 0)
-    boot();
-    print_status();
+    boot(sim);
+    print_status(sim);
     status.cycle++;
 
     // cycle 1부터 시작
     while (true) {
-        perform_cycle();
+        perform_cycle(sim);
 
         // 종료되는 프로세스가 init (종료 조건) -> 탈출
         if (status.process_terminated != nullptr) {
             if (status.process_terminated->pid == 1) {
-                delete status.process_terminated;
+                status.process_pool.destroy(status.process_terminated);
                 status.process_terminated = nullptr;
                 break;
             }
         }
+
+        // 모든 프로세스가 깨어날 수 없이 막힘 (예: sleep 0) -> 탈출
+        if (status.process_running == nullptr && status.process_ready.empty() && status.process_new == nullptr
+            && status.process_sleeping.empty() && status.task == Idle_task) {
+            fprintf(stderr, "no process can be scheduled\n");
+            break;
+        }
     }
 
-    fclose(result_file);
+    if (sim.output_mode != No_trace) {
+        sim.trace.close();
+    }
+    sim.references.close();
+
+    status.stats.peak_swap_size = status.swap_space.peak_size();
+    if (!sim.stats_filename.empty()) {
+        FILE* stats_file = fopen(sim.stats_filename.c_str(), "w");
+        if (stats_file == nullptr) {
+            fprintf(stderr, "cannot open %s\n", sim.stats_filename.c_str());
+        } else {
+            status.stats.write(stats_file, sim.stats_mode, replacement_policy, status.cycle);
+            fclose(stats_file);
+        }
+    }
+}
+
+void run(const std::string &run_path, const std::string &replacement_policy, const std::string &result_filename,
+         trace_mode mode, victim_search search, const MemoryGeometry &geometry) {
+    Simulator sim;
+    run(sim, run_path, replacement_policy, result_filename, mode, search, geometry);
+}
+
+/**
+ * 한 줄에 프레임 단위로 구분된 칸을 출력할 때 칸 뒤에 붙는 구분자
+ * @param i 칸 인덱스
+ * @param unit 한 묶음의 칸 수
+ */
+static inline char cell_separator(int i, int unit) {
+    return i % unit == unit - 1 ? '|' : ' ';
 }
 
-void print_status() {
+void print_status(Simulator &sim) {
+    Status &status = sim.status;
+    ScopedTimer timer(status.stats.timer(status.stats.print_status_timer));
+    switch (sim.output_mode) {
+        case Text_trace:
+            print_text_status(sim);
+            break;
+        case Binary_trace:
+            sim.binary_trace.record(status);
+            break;
+        case No_trace:
+            break;
+    }
+}
+
+void print_text_status(Simulator &sim) {
+    const Status &status = sim.status;
+    TraceWriter &trace = sim.trace;
     // 0. 몇번째 cycle인지
-    fprintf(result_file, "[cycle #%d]\n", status.cycle);
+    trace.write("[cycle #");
+    trace.write_int(status.cycle);
+    trace.write("]\n");
 
     // 1. 현재 실행 모드 (user or kernel)
-    fprintf(result_file, "1. mode: %s\n", status.mode.c_str());
+    trace.write("1. mode: ");
+    trace.write(status.mode);
+    trace.write('\n');
 
     // 2. 현재 실행 명령어
-    fprintf(result_file, "2. command: %s\n", status.command.c_str());
+    trace.write("2. command: ");
+    trace.write(*status.command);
+    trace.write('\n');
 
     // 3. 현재 실행중인 프로세스의 정보. 없을 시 none 출력
     if (status.process_running == nullptr) {
-        fprintf(result_file, "3. running: none\n");
+        trace.write("3. running: none\n");
     } else {
         Process *i = status.process_running;
-        fprintf(result_file, "3. running: %d(%s, %d)\n", i->pid, i->name.c_str(), i->ppid);
+        trace.write("3. running: ");
+        trace.write_int(i->pid);
+        trace.write('(');
+        trace.write(i->name);
+        trace.write(", ");
+        trace.write_int(i->ppid);
+        trace.write(")\n");
     }
 
     // 4. 현재 물리 메모리 상황
-    fprintf(result_file, "4. physical memory:\n");
-
-    fprintf(result_file, "|");
-    for (int i = 0; i < PHYSICAL_MEMORY_SIZE; i++) {
-        if (status.physical_memory[i] == nullptr) {
-            fprintf(result_file, "-");
-        } else {
-            fprintf(result_file, "%d(%d)", status.physical_memory[i]->process_id, status.physical_memory[i]->page_id);
-        }
+    trace.write("4. physical memory:\n");
 
-        if (i % PRINT_FRAME_UNIT == PRINT_FRAME_UNIT - 1) {
-            fprintf(result_file, "|");
+    trace.write('|');
+    for (int i = 0; i < status.geometry.physical_memory_size; i++) {
+        if (!status.physical_memory.is_occupied(i)) {
+            trace.write('-');
         } else {
-            fprintf(result_file, " ");
+            trace.write_int(status.physical_memory.process_id[i]);
+            trace.write('(');
+            trace.write_int(status.physical_memory.page_id[i]);
+            trace.write(')');
         }
+        trace.write(cell_separator(i, status.geometry.print_frame_unit));
     }
-    fprintf(result_file, "\n");
+    trace.write('\n');
 
     // 현재 Running 상태의 프로세스가 없으면 아래 정보는 출력되지 않는다.
     if (status.process_running == nullptr) {
-        fprintf(result_file, "\n");
+        trace.write('\n');
         return;
     }
 
     // 5. 현재 실행중인 프로세스의 가상 메모리 상황
-    fprintf(result_file, "5. virtual memory:\n");
+    trace.write("5. virtual memory:\n");
 
-    fprintf(result_file, "|");
-    for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
+    trace.write('|');
+    for (int i = 0; i < status.geometry.virtual_memory_size; i++) {
         if (status.process_running->virtual_memory[i] == -1) {
-            fprintf(result_file, "-");
-        } else {
-            fprintf(result_file, "%d", status.process_running->virtual_memory[i]);
-        }
-
-        if (i % PRINT_FRAME_UNIT == PRINT_FRAME_UNIT - 1) {
-            fprintf(result_file, "|");
+            trace.write('-');
         } else {
-            fprintf(result_file, " ");
+            trace.write_int(status.process_running->virtual_memory[i]);
         }
+        trace.write(cell_separator(i, status.geometry.print_frame_unit));
     }
-    fprintf(result_file, "\n");
+    trace.write('\n');
 
     // 6. 현재 실행중인 프로세스의 페이지 테이블 상황
-    fprintf(result_file, "6. page table:\n");
+    trace.write("6. page table:\n");
 
     // 페이지 테이블 매핑 정보
-    fprintf(result_file, "|");
-    for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
+    trace.write('|');
+    for (int i = 0; i < status.geometry.virtual_memory_size; i++) {
         // 페이지 테이블 엔트리가 없거나 스왑 영역에 있을 때
         if (status.process_running->page_table[i] == nullptr
             || status.process_running->page_table[i]->physical_address == -1) {
-            fprintf(result_file, "-");
-        } else {
-            fprintf(result_file, "%d", status.process_running->page_table[i]->physical_address);
-        }
-
-        if (i % PRINT_FRAME_UNIT == PRINT_FRAME_UNIT - 1) {
-            fprintf(result_file, "|");
+            trace.write('-');
         } else {
-            fprintf(result_file, " ");
+            trace.write_int(status.process_running->page_table[i]->physical_address);
         }
+        trace.write(cell_separator(i, status.geometry.print_frame_unit));
     }
-    fprintf(result_file, "\n");
+    trace.write('\n');
 
     // 페이지 테이블 권한 정보
-    fprintf(result_file, "|");
-    for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
+    trace.write('|');
+    for (int i = 0; i < status.geometry.virtual_memory_size; i++) {
         // 페이지 테이블 엔트리가 없을때
         if (status.process_running->page_table[i] == nullptr) {
-            fprintf(result_file, "-");
+            trace.write('-');
         } else {
-            fprintf(result_file, "%c", status.process_running->page_table[i]->authority);
-        }
-
-        if (i % PRINT_FRAME_UNIT == PRINT_FRAME_UNIT - 1) {
-            fprintf(result_file, "|");
-        } else {
-            fprintf(result_file, " ");
+            trace.write(status.process_running->page_table[i]->authority);
         }
+        trace.write(cell_separator(i, status.geometry.print_frame_unit));
     }
-    fprintf(result_file, "\n");
+    trace.write('\n');
 
 
     // 매 cycle 간의 정보는 두번의 개행으로 구분
-    fprintf(result_file, "\n");
-}
\ No newline at end of file
+    trace.write('\n');
+}
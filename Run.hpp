@@ -6,51 +6,99 @@
 #define HW3_RUN_HPP
 
 #include "System.hpp"
+#include "Program.hpp"
+#include "Trace.hpp"
+#include "BinaryTrace.hpp"
+#include "ReferenceStream.hpp"
 
-const int PRINT_FRAME_UNIT = 4;
-
-namespace Run {
-    // 결과 출력 파일 스트림
-    extern FILE* result_file;
-    // Global Status
-    extern Status status;
+/**
+ * 시뮬레이션 한 번을 실행하는 데 필요한 모든 상태\n
+ * 전역 상태를 두지 않으므로 서로 다른 Simulator는 각자의 스레드에서 동시에 실행할 수 있다.
+ */
+struct Simulator {
+    // 결과 출력
+    TraceWriter trace;
+    // 결과 출력 형식
+    trace_mode output_mode = Text_trace;
+    // 바이너리 형식일 때 사용하는 인코더
+    BinaryTraceEncoder binary_trace;
+    // 시뮬레이터 상태
+    Status status;
     // Executing directory
-    extern std::string path;
-}
+    std::string path;
+    // 읽어 들인 프로그램 이미지 캐시
+    ProgramCache programs;
+    // 실행이 끝나면 통계를 쓸 파일 (비어 있으면 쓰지 않음)
+    std::string stats_filename;
+    stats_format stats_mode = Json_stats;
+    // replace_page, run_program, print_status 벽시계 시간 측정
+    bool timers_enabled = false;
+    // 비어 있지 않으면 프레임 참조 스트림을 이 파일에 기록 (OPT 사전 실행)
+    std::string reference_filename;
+    ReferenceRecorder references;
+};
 
 
-std::vector<std::string> split(const std::string& str, char delim = ' ');
-
 /**
- * 현재 프로세스의 명령어를 읽고 명령어를 리턴
- * @param path 파일 경로
- * @param file_name 파일 이름
- * @param status status
+ * 현재 프로세스의 프로그램 이미지에서 명령어를 읽고 디코딩된 명령어를 리턴\n
+ * 출력용 명령어 원문은 status.command가 가리키게 함 (복사하지 않음)
+ * @param sim 실행 중인 시뮬레이터
  * @return 읽은 명령어
  */
-std::string run_program();
+Instruction run_program(Simulator &sim);
 
 /**
  * 명령 실행 전 업데이트\n
  * 1. sleep시간 갱신\n
  * 2. 프로세스 상태 갱신\n
  * 3. ready queue 갱신\n
- * @param status status 변수
+ * @param sim 실행 중인 시뮬레이터
  */
-void update();
+void update(Simulator &sim);
 
 /**
  * 1 cycle 실행 (run일때는 argument만큼 cycle 실행)
- * @param status
- * @param path
+ * @param sim 실행 중인 시뮬레이터
+ */
+void perform_cycle(Simulator &sim);
+
+/**
+ * 주어진 시뮬레이터에서 커널 시뮬레이션 실행
+ * @param sim 실행할 시뮬레이터 (이전 실행 상태는 초기화됨)
+ * @param run_path 프로그램 디렉토리
+ * @param replacement_policy 페이지 교체 알고리즘
+ * @param result_filename 결과 파일 이름
+ * @param mode 결과 출력 형식
+ * @param search 교체 대상 선택 방식
+ * @param geometry 메모리 구성
+ */
+void run(Simulator &sim, const std::string& run_path, const std::string& replacement_policy,
+         const std::string& result_filename = "result", trace_mode mode = Text_trace,
+         victim_search search = Indexed_victim_search, const MemoryGeometry& geometry = MemoryGeometry());
+
+/**
+ * 새 시뮬레이터를 만들어 커널 시뮬레이터 실행
+ * @param run_path 프로그램 디렉토리
+ * @param replacement_policy 페이지 교체 알고리즘
+ * @param result_filename 결과 파일 이름
+ * @param mode 결과 출력 형식
+ * @param search 교체 대상 선택 방식
+ * @param geometry 메모리 구성
  */
-void perform_cycle();
+void run(const std::string& run_path, const std::string& replacement_policy, const std::string& result_filename = "result",
+         trace_mode mode = Text_trace, victim_search search = Indexed_victim_search,
+         const MemoryGeometry& geometry = MemoryGeometry());
 
 /**
- * 커널 시뮬레이터 실행
+ * 현재 cycle의 상태를 결과 파일에 출력 (출력 형식에 따라 텍스트, 바이너리, 또는 출력 안 함)
+ * @param sim 실행 중인 시뮬레이터
  */
-void run(const std::string& run_path, const std::string& replacement_policy, const std::string& result_filename = "result");
+void print_status(Simulator &sim);
 
-void print_status();
+/**
+ * 현재 cycle의 상태를 텍스트 형식으로 출력
+ * @param sim 실행 중인 시뮬레이터
+ */
+void print_text_status(Simulator &sim);
 
 #endif //HW3_RUN_HPP
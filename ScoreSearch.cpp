@@ -0,0 +1,195 @@
+#include "ScoreSearch.hpp"
+#include <limits>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCORE_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+const int MIN_SENTINEL = std::numeric_limits<int>::max();
+const int MAX_SENTINEL = -1;
+
+// scalar: 두 단계로 나눠 리덕션 반복문이 분기 없이 벡터화되도록 한다
+// 1. 빈 프레임을 항등원으로 가린 min/max 리덕션 (삼항 연산자 대신 비트 마스크로 가려야 벡터화됨)
+// 2. 그 값을 가진 첫 번째 주소 탐색
+
+static int argmin_scalar(const int* score, const uint8_t* occupied, int n) {
+    int min_score = MIN_SENTINEL;
+    for (int i = 0; i < n; i++) {
+        int keep = -(int) occupied[i];
+        int value = (score[i] & keep) | (MIN_SENTINEL & ~keep);
+        min_score = value < min_score ? value : min_score;
+    }
+    if (min_score == MIN_SENTINEL) return -1;
+    for (int i = 0; i < n; i++) {
+        if (occupied[i] && score[i] == min_score) return i;
+    }
+    return -1;
+}
+
+static int argmax_scalar(const int* score, const uint8_t* occupied, int n) {
+    int max_score = MAX_SENTINEL;
+    for (int i = 0; i < n; i++) {
+        int keep = -(int) occupied[i];
+        int value = (score[i] & keep) | (MAX_SENTINEL & ~keep);
+        max_score = value > max_score ? value : max_score;
+    }
+    if (max_score == MAX_SENTINEL) return -1;
+    for (int i = 0; i < n; i++) {
+        if (occupied[i] && score[i] == max_score) return i;
+    }
+    return -1;
+}
+
+#ifdef SCORE_SEARCH_X86
+
+// SIMD: lane마다 (최소/최대 점수, 그 점수가 처음 나온 주소)를 한 번에 유지하고
+// 마지막에 lane끼리 (점수, 주소) 순으로 합친 뒤 남은 꼬리를 scalar로 처리한다.
+// 빈 프레임은 sentinel로 가리며, 엄격한 비교만 쓰므로 sentinel은 후보가 되지 않는다.
+
+/**
+ * lane별 결과를 합침 (동점이면 낮은 주소)
+ * @param minimum true면 argmin, false면 argmax
+ */
+static void merge_lanes(const int* values, const int* indices, int lanes, bool minimum,
+                        int& best_score, int& best_index) {
+    for (int lane = 0; lane < lanes; lane++) {
+        if (indices[lane] == -1) continue;
+        bool better = minimum ? values[lane] < best_score : values[lane] > best_score;
+        if (better || (values[lane] == best_score && indices[lane] < best_index)) {
+            best_score = values[lane];
+            best_index = indices[lane];
+        }
+    }
+}
+
+template<bool Minimum>
+__attribute__((target("sse4.1")))
+static int search_sse41(const int* score, const uint8_t* occupied, int n) {
+    const int sentinel = Minimum ? MIN_SENTINEL : MAX_SENTINEL;
+    const __m128i sentinels = _mm_set1_epi32(sentinel);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i best = sentinels;
+    __m128i best_index = _mm_set1_epi32(-1);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask_bytes;
+        memcpy(&mask_bytes, occupied + i, sizeof(mask_bytes));
+        __m128i empty = _mm_cmpeq_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(mask_bytes)), zero);
+        __m128i value = _mm_blendv_epi8(_mm_loadu_si128((const __m128i*) (score + i)), sentinels, empty);
+        __m128i better = Minimum ? _mm_cmpgt_epi32(best, value) : _mm_cmpgt_epi32(value, best);
+        best = _mm_blendv_epi8(best, value, better);
+        best_index = _mm_blendv_epi8(best_index, index, better);
+        index = _mm_add_epi32(index, step);
+    }
+
+    alignas(16) int values[4];
+    alignas(16) int indices[4];
+    _mm_store_si128((__m128i*) values, best);
+    _mm_store_si128((__m128i*) indices, best_index);
+    int best_score = sentinel;
+    int result = -1;
+    merge_lanes(values, indices, 4, Minimum, best_score, result);
+
+    for (; i < n; i++) {
+        if (!occupied[i]) continue;
+        if (Minimum ? score[i] < best_score : score[i] > best_score) {
+            best_score = score[i];
+            result = i;
+        }
+    }
+    return result;
+}
+
+template<bool Minimum>
+__attribute__((target("avx2")))
+static int search_avx2(const int* score, const uint8_t* occupied, int n) {
+    const int sentinel = Minimum ? MIN_SENTINEL : MAX_SENTINEL;
+    const __m256i sentinels = _mm256_set1_epi32(sentinel);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i best = sentinels;
+    __m256i best_index = _mm256_set1_epi32(-1);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i mask_bytes = _mm_loadl_epi64((const __m128i*) (occupied + i));
+        __m256i empty = _mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(mask_bytes), zero);
+        __m256i value = _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i*) (score + i)), sentinels, empty);
+        __m256i better = Minimum ? _mm256_cmpgt_epi32(best, value) : _mm256_cmpgt_epi32(value, best);
+        best = _mm256_blendv_epi8(best, value, better);
+        best_index = _mm256_blendv_epi8(best_index, index, better);
+        index = _mm256_add_epi32(index, step);
+    }
+
+    alignas(32) int values[8];
+    alignas(32) int indices[8];
+    _mm256_store_si256((__m256i*) values, best);
+    _mm256_store_si256((__m256i*) indices, best_index);
+    int best_score = sentinel;
+    int result = -1;
+    merge_lanes(values, indices, 8, Minimum, best_score, result);
+
+    for (; i < n; i++) {
+        if (!occupied[i]) continue;
+        if (Minimum ? score[i] < best_score : score[i] > best_score) {
+            best_score = score[i];
+            result = i;
+        }
+    }
+    return result;
+}
+
+#endif
+
+bool score_search_supported(score_search_kernel kernel) {
+    switch (kernel) {
+        case Scalar_score_search:
+            return true;
+#ifdef SCORE_SEARCH_X86
+        case Sse41_score_search:
+            return __builtin_cpu_supports("sse4.1");
+        case Avx2_score_search:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+ScoreSearch score_search_for(score_search_kernel kernel) {
+    switch (kernel) {
+#ifdef SCORE_SEARCH_X86
+        case Sse41_score_search:
+            return {kernel, search_sse41<true>, search_sse41<false>};
+        case Avx2_score_search:
+            return {kernel, search_avx2<true>, search_avx2<false>};
+#endif
+        default:
+            return {Scalar_score_search, argmin_scalar, argmax_scalar};
+    }
+}
+
+const ScoreSearch& score_search() {
+    static const ScoreSearch selected = score_search_for(
+            score_search_supported(Avx2_score_search) ? Avx2_score_search
+            : score_search_supported(Sse41_score_search) ? Sse41_score_search
+            : Scalar_score_search);
+    return selected;
+}
+
+std::string score_search_kernel_to_str(score_search_kernel kernel) {
+    switch (kernel) {
+        case Sse41_score_search:
+            return SSE41_SCORE_SEARCH_STRING;
+        case Avx2_score_search:
+            return AVX2_SCORE_SEARCH_STRING;
+        default:
+            return SCALAR_SCORE_SEARCH_STRING;
+    }
+}
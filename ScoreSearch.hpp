@@ -0,0 +1,50 @@
+#ifndef HW3_SCORE_SEARCH_HPP
+#define HW3_SCORE_SEARCH_HPP
+
+#include <string>
+#include <cstdint>
+
+/**
+ * 교체 대상 탐색 커널 (마스크된 argmin/argmax)
+ */
+enum score_search_kernel {
+    Scalar_score_search, // 이식 가능한 C++ (컴파일러 자동 벡터화)
+    Sse41_score_search,
+    Avx2_score_search,
+};
+
+const std::string SCALAR_SCORE_SEARCH_STRING = "scalar";
+const std::string SSE41_SCORE_SEARCH_STRING = "sse4.1";
+const std::string AVX2_SCORE_SEARCH_STRING = "avx2";
+
+/**
+ * 사용 중인 프레임(occupied != 0)의 점수 중 최소(또는 최대)인 주소를 찾는 함수\n
+ * 동점이면 가장 낮은 주소를 돌려주며, 기존 선형 탐색처럼 최소는 INT_MAX보다 작은 점수,
+ * 최대는 -1보다 큰 점수만 후보로 본다. 후보가 없으면 -1.
+ */
+typedef int (*score_search_function)(const int* score, const uint8_t* occupied, int n);
+
+struct ScoreSearch {
+    score_search_kernel kernel;
+    score_search_function argmin;
+    score_search_function argmax;
+};
+
+/**
+ * 현재 CPU에서 커널을 실행할 수 있는지
+ */
+bool score_search_supported(score_search_kernel kernel);
+
+/**
+ * 지정한 커널 (지원 여부는 score_search_supported로 먼저 확인)
+ */
+ScoreSearch score_search_for(score_search_kernel kernel);
+
+/**
+ * 실행 중인 CPU가 지원하는 가장 빠른 커널 (처음 호출할 때 한 번 선택)
+ */
+const ScoreSearch& score_search();
+
+std::string score_search_kernel_to_str(score_search_kernel kernel);
+
+#endif //HW3_SCORE_SEARCH_HPP
@@ -0,0 +1,146 @@
+// 교체 대상 탐색 커널 마이크로벤치마크
+// 사용법: score_search_bench [frame_count ...]
+// 기존 구현(프레임 포인터 배열을 따라가며 점수를 비교하는 반복문)과 scalar, SSE4.1, AVX2 커널을
+// 같은 점수 배열에서 비교하고, 모든 커널의 결과가 기존 구현과 같은지 확인한다.
+
+#include "ScoreSearch.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+// 탐색 한 종류당 훑는 프레임 수의 합
+const long long ELEMENTS_PER_MEASURE = 1LL << 26;
+
+/**
+ * SoA 이전의 PhysicalFrame과 같은 배치의 프레임
+ */
+struct FrameRecord {
+    int process_id;
+    int page_id;
+    void* linked_page;
+    int ru_score;
+    int fi_score;
+    int fu_score;
+};
+
+/**
+ * 기존 Status::replace_page()의 LRU 선형 탐색
+ */
+static int pointer_argmin(const std::vector<FrameRecord*>& frames) {
+    int min_score = std::numeric_limits<int>::max();
+    int replace_index = -1;
+    int iteration = 0;
+    for (auto& m: frames) {
+        if (m == nullptr) {iteration++; continue;}
+        if (m->ru_score < min_score) {
+            min_score = m->ru_score;
+            replace_index = iteration;
+        }
+        iteration++;
+    }
+    return replace_index;
+}
+
+/**
+ * 기존 Status::replace_page()의 MFU 선형 탐색
+ */
+static int pointer_argmax(const std::vector<FrameRecord*>& frames) {
+    int max_score = -1;
+    int replace_index = -1;
+    int iteration = 0;
+    for (auto& m: frames) {
+        if (m == nullptr) {iteration++; continue;}
+        if (m->fu_score > max_score) {
+            max_score = m->fu_score;
+            replace_index = iteration;
+        }
+        iteration++;
+    }
+    return replace_index;
+}
+
+template<typename Search>
+static double measure(int repeat, Search search, long long& sink) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        sink += search();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / repeat;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> frame_counts;
+    for (int i = 1; i < argc; i++) {
+        int count = atoi(argv[i]);
+        if (count <= 0) {
+            fprintf(stderr, "usage: score_search_bench [frame_count ...]\n");
+            return 1;
+        }
+        frame_counts.push_back(count);
+    }
+    if (frame_counts.empty()) frame_counts = {16, 256, 4096, 65536, 1048576};
+
+    std::vector<score_search_kernel> kernels;
+    for (auto kernel: {Scalar_score_search, Sse41_score_search, Avx2_score_search}) {
+        if (score_search_supported(kernel)) kernels.push_back(kernel);
+    }
+
+    std::mt19937 random(2026);
+    long long sink = 0;
+    bool mismatch = false;
+
+    printf("%10s  %-8s  %-7s  %12s  %8s\n", "frames", "search", "kernel", "ns/search", "speedup");
+    for (int frame_count: frame_counts) {
+        // 90%의 프레임이 사용 중인 물리 메모리 (점수는 작은 범위에서 뽑아 동점이 생기게 함)
+        std::vector<std::unique_ptr<FrameRecord>> storage;
+        std::vector<FrameRecord*> frames(frame_count, nullptr);
+        std::vector<int> ru_score(frame_count, 0);
+        std::vector<int> fu_score(frame_count, 0);
+        std::vector<uint8_t> occupied(frame_count, 0);
+        std::uniform_int_distribution<int> score_distribution(0, frame_count);
+        std::uniform_int_distribution<int> frequency_distribution(1, 32);
+        std::uniform_int_distribution<int> occupancy(0, 9);
+        for (int i = 0; i < frame_count; i++) {
+            if (occupancy(random) == 0) continue;
+            storage.push_back(std::unique_ptr<FrameRecord>(new FrameRecord{1, i, nullptr, score_distribution(random),
+                                                                           0, frequency_distribution(random)}));
+            frames[i] = storage.back().get();
+            ru_score[i] = frames[i]->ru_score;
+            fu_score[i] = frames[i]->fu_score;
+            occupied[i] = 1;
+        }
+
+        int repeat = (int) std::max<long long>(1, ELEMENTS_PER_MEASURE / frame_count);
+        for (bool minimum: {true, false}) {
+            const char* search_name = minimum ? "argmin" : "argmax";
+            int expected = minimum ? pointer_argmin(frames) : pointer_argmax(frames);
+            double baseline = measure(repeat, [&]() {
+                return minimum ? pointer_argmin(frames) : pointer_argmax(frames);
+            }, sink);
+            printf("%10d  %-8s  %-7s  %12.1f  %7.2fx\n", frame_count, search_name, "pointer", baseline, 1.0);
+
+            for (auto kernel: kernels) {
+                ScoreSearch search = score_search_for(kernel);
+                score_search_function function = minimum ? search.argmin : search.argmax;
+                const std::vector<int>& score = minimum ? ru_score : fu_score;
+                if (function(score.data(), occupied.data(), frame_count) != expected) {
+                    fprintf(stderr, "%s %s result differs from the linear search\n",
+                            score_search_kernel_to_str(kernel).c_str(), search_name);
+                    mismatch = true;
+                }
+                double elapsed = measure(repeat, [&]() {
+                    return function(score.data(), occupied.data(), frame_count);
+                }, sink);
+                printf("%10d  %-8s  %-7s  %12.1f  %7.2fx\n", frame_count, search_name,
+                       score_search_kernel_to_str(kernel).c_str(), elapsed, baseline / elapsed);
+            }
+        }
+    }
+    printf("selected kernel: %s (checksum %lld)\n", score_search_kernel_to_str(score_search().kernel).c_str(), sink);
+    return mismatch ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+// 시뮬레이터 핵심 함수 마이크로벤치마크와 합성 워크로드 매크로벤치마크 (Google Benchmark)
+// 사용법: simulator_bench [--benchmark_filter=...] [--benchmark_out=bench.json --benchmark_out_format=json]
+// make bench는 결과를 bench.json에 기록한다.
+
+#include "Run.hpp"
+#include "Workload.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+const page_replacement_policy POLICIES[] = {FIFO, LRU, LFU, MFU, CLOCK, SECOND_CHANCE, CLOCK_PRO, ARC, TWO_Q, OPT};
+const std::string POLICY_STRINGS[] = {FIFO_STRING, LRU_STRING, LFU_STRING, MFU_STRING, CLOCK_STRING,
+                                      SECOND_CHANCE_STRING, CLOCK_PRO_STRING, ARC_STRING, TWO_Q_STRING,
+                                      OPT_STRING};
+const trace_mode TRACE_MODES[] = {No_trace, Text_trace, Binary_trace};
+const char* const TRACE_MODE_NAMES[] = {"none", "text", "binary"};
+const char* const NULL_DEVICE = "/dev/null";
+const std::string BENCH_COMMAND_STRING = "memory_read 0";
+
+/**
+ * 물리 메모리 크기만 바꾼 메모리 구성 (스왑 영역은 물리 메모리에 맞춰 늘림)
+ */
+static MemoryGeometry geometry_with(int physical_memory_size) {
+    MemoryGeometry geometry;
+#ifndef FIXED_GEOMETRY
+    geometry.physical_memory_size = physical_memory_size;
+    geometry.swap_space_size = std::max(SWAP_SPACE_SIZE, physical_memory_size * 2);
+#else
+    (void) physical_memory_size;
+#endif
+    return geometry;
+}
+
+/**
+ * 물리 메모리를 모두 채운 상태 (pid 1의 page id = 물리 메모리 주소)\n
+ * 접근 점수가 고르지 않도록 일부 프레임에 memory_read를 흉내 낸 접근을 기록한다.
+ */
+static void fill_physical_memory(Status& status, std::mt19937& random) {
+    int frame_count = status.geometry.physical_memory_size;
+    for (int address = 0; address < frame_count; address++) {
+        PhysicalFrame frame(1, address, status.top_fi_score++, 1, status.top_ru_score++);
+        frame.linked_page = status.page_pool.create(address, address);
+        status.place_frame(address, frame);
+    }
+    std::uniform_int_distribution<int> address_distribution(0, frame_count - 1);
+    for (int i = 0; i < frame_count * 4; i++) {
+        status.access_frame(address_distribution(random));
+    }
+}
+
+/**
+ * 페이지 폴트 한 번의 교체 경로: replace_page()로 교체 대상을 스왑 영역으로 내보내고
+ * page_fault_handler처럼 그 프레임을 다시 빈 자리에 배치한다 (물리 메모리는 계속 가득 찬 상태로 유지됨)
+ * 인자: 정책, 교체 대상 선택 방식(0 indexed, 1 scan), 물리 메모리 크기
+ */
+static void BM_ReplacePage(benchmark::State& state) {
+    Status status;
+    status.replacement_policy = POLICIES[state.range(0)];
+    status.victim_search_mode = state.range(1) == 0 ? Indexed_victim_search : Scan_victim_search;
+    status.configure(geometry_with((int) state.range(2)));
+    std::mt19937 random(2026);
+    fill_physical_memory(status, random);
+
+    for (auto _: state) {
+        status.replace_page();
+        int address = status.first_free_memory_address();
+        PhysicalFrame* frame = status.swap_space.take(1, status.physical_memory.page_id[address]);
+        frame->fi_score = status.top_fi_score++;
+        frame->fu_score++;
+        frame->ru_score = status.top_ru_score++;
+        frame->linked_page->physical_address = address;
+        status.place_frame(address, *frame);
+        status.frame_pool.destroy(frame);
+    }
+    state.SetLabel(POLICY_STRINGS[state.range(0)] + (state.range(1) == 0 ? "/indexed" : "/scan"));
+}
+
+/**
+ * memory_allocate가 빈 물리 메모리 주소를 찾는 비용 (절반이 비어 있는 물리 메모리에서 빈 주소의 절반 요청)
+ * 인자: 물리 메모리 크기
+ */
+static void BM_FreeMemoryAddresses(benchmark::State& state) {
+    Status status;
+    status.replacement_policy = LRU;
+    status.configure(geometry_with((int) state.range(0)));
+    std::mt19937 random(2026);
+    int frame_count = status.geometry.physical_memory_size;
+    for (int address = 0; address < frame_count; address++) {
+        if (random() % 2 == 0) status.free_frames.occupy(address);
+    }
+    int request = std::max(1, status.free_memory_size() / 2);
+
+    for (auto _: state) {
+        auto addresses = status.free_memory_addresses(request);
+        benchmark::DoNotOptimize(addresses.data());
+    }
+    state.SetItemsProcessed(state.iterations() * request);
+}
+
+/**
+ * 유저 모드 명령어 하나를 읽는 비용 (프로그램 끝에 닿으면 처음부터 다시 읽음)
+ * 인자: 프로그램 줄 수
+ */
+static void BM_RunProgram(benchmark::State& state) {
+    Simulator sim;
+    Status& status = sim.status;
+    status.replacement_policy = LRU;
+    status.configure(MemoryGeometry());
+
+    ProgramImage image;
+    image.name = "bench";
+    const std::string commands[] = {"memory_read 0", "memory_write 1", "run 3", "sleep 2", "memory_allocate 4"};
+    const Instruction instructions[] = {{Op_memory_read, 0}, {Op_memory_write, 1}, {Op_run, 3}, {Op_sleep, 2},
+                                        {Op_memory_allocate, 4}};
+    for (int i = 0; i < state.range(0); i++) {
+        image.lines.push_back(commands[i % 5]);
+        image.code.push_back(instructions[i % 5]);
+    }
+    Process* p = status.process_pool.create("bench", 1, 0, status.geometry, Running);
+    p->image = &image;
+    status.process_running = p;
+
+    for (auto _: state) {
+        Instruction instruction = run_program(sim);
+        benchmark::DoNotOptimize(instruction);
+        if (p->current_line > (int) image.lines.size()) p->current_line = 1;
+    }
+}
+
+/**
+ * 한 cycle의 상태 출력 비용 (물리 메모리와 실행 중인 프로세스의 가상 메모리가 채워진 상태, 출력은 /dev/null)
+ * 인자: 출력 형식(0 none, 1 text, 2 binary), 물리 메모리 크기
+ */
+static void BM_PrintStatus(benchmark::State& state) {
+    Simulator sim;
+    Status& status = sim.status;
+    status.replacement_policy = LRU;
+    status.configure(geometry_with((int) state.range(1)));
+    std::mt19937 random(2026);
+    fill_physical_memory(status, random);
+
+    Process* p = status.process_pool.create("bench", 1, 0, status.geometry, Running);
+    for (int address = 0; address < status.geometry.virtual_memory_size && address < status.geometry.physical_memory_size;
+         address++) {
+        p->map_page(address, address);
+        p->page_table[address] = status.physical_memory.linked_page[address];
+    }
+    status.process_running = p;
+    status.mode = USER_MODE_STRING;
+    status.command = &BENCH_COMMAND_STRING;
+
+    sim.output_mode = TRACE_MODES[state.range(0)];
+    if (sim.output_mode != No_trace) sim.trace.open(fopen(NULL_DEVICE, "wb"));
+    if (sim.output_mode == Binary_trace) sim.binary_trace.open(&sim.trace, status.geometry);
+
+    for (auto _: state) {
+        print_status(sim);
+        // 바이너리 형식은 변경분만 기록하므로 매번 접근 점수가 바뀐 것처럼 프레임 하나를 갱신
+        status.access_frame((int) (status.cycle % status.geometry.physical_memory_size));
+        status.cycle++;
+    }
+    if (sim.output_mode != No_trace) sim.trace.close();
+    state.SetLabel(TRACE_MODE_NAMES[state.range(0)]);
+}
+
+const access_pattern PATTERNS[] = {Uniform_access, Sequential_access, Zipfian_access, Working_set_access,
+                                   Fork_heavy_access};
+
+// 합성 워크로드를 만드는 임시 디렉토리 (처음 사용할 때 생성하고 main이 끝날 때 삭제)
+static std::string generated_workload_directory;
+
+/**
+ * 접근 패턴별 합성 워크로드 프로그램 디렉토리 (처음 사용할 때 한 번 생성)
+ */
+static std::string workload_directory(access_pattern pattern) {
+    if (generated_workload_directory.empty()) {
+        char path[] = "/tmp/simulator_bench.XXXXXX";
+        if (mkdtemp(path) == nullptr) {
+            fprintf(stderr, "cannot create workload directory\n");
+            exit(1);
+        }
+        generated_workload_directory = path;
+    }
+    std::string directory = generated_workload_directory + "/" + access_pattern_to_str(pattern);
+    if (!std::filesystem::exists(directory)) {
+        WorkloadOptions options;
+        options.pattern = pattern;
+        if (!std::filesystem::create_directory(directory) || !write_workload(directory, options)) {
+            fprintf(stderr, "cannot create workload directory\n");
+            exit(1);
+        }
+    }
+    return directory;
+}
+
+/**
+ * 합성 워크로드 전체 실행 (init부터 종료까지), 초당 시뮬레이션 cycle 수를 cycles_per_second로,
+ * 정책끼리 비교할 수 있도록 적중과 폴트 횟수를 memory_hits, page_faults로 보고
+ */
+static void run_workload(benchmark::State& state, access_pattern pattern, const std::string& policy, trace_mode mode,
+                         const MemoryGeometry& geometry) {
+    std::string directory = workload_directory(pattern);
+    Simulator sim;
+    long long cycles = 0;
+    for (auto _: state) {
+        run(sim, directory + "/", policy, NULL_DEVICE, mode, Indexed_victim_search, geometry);
+        cycles += sim.status.cycle;
+    }
+    state.counters["cycles"] = benchmark::Counter((double) sim.status.cycle);
+    state.counters["cycles_per_second"] = benchmark::Counter((double) cycles, benchmark::Counter::kIsRate);
+    state.counters["memory_hits"] = benchmark::Counter((double) sim.status.stats.memory_hits);
+    state.counters["page_faults"] = benchmark::Counter((double) sim.status.stats.page_faults);
+    state.counters["protection_faults"] = benchmark::Counter((double) sim.status.stats.protection_faults);
+}
+
+/**
+ * 균등 접근 워크로드
+ * 인자: 정책, 출력 형식(0 none, 1 text, 2 binary), 물리 메모리 크기
+ */
+static void BM_Workload(benchmark::State& state) {
+    const std::string& policy = POLICY_STRINGS[state.range(0)];
+    run_workload(state, Uniform_access, policy, TRACE_MODES[state.range(1)], geometry_with((int) state.range(2)));
+    state.SetLabel(policy + "/" + TRACE_MODE_NAMES[state.range(1)]);
+}
+
+/**
+ * 접근 패턴별 워크로드 (출력 없음, 기본 메모리 구성)
+ * 인자: 접근 패턴, 정책
+ */
+static void BM_WorkloadPattern(benchmark::State& state) {
+    access_pattern pattern = PATTERNS[state.range(0)];
+    const std::string& policy = POLICY_STRINGS[state.range(1)];
+    run_workload(state, pattern, policy, No_trace, MemoryGeometry());
+    state.SetLabel(access_pattern_to_str(pattern) + "/" + policy);
+}
+
+// CLOCK 계열은 선형 탐색 방식도 Replacer를 사용하므로 indexed만 측정
+BENCHMARK(BM_ReplacePage)->ArgsProduct({{0, 1, 2, 3}, {0, 1}, {16, 256, 4096}});
+BENCHMARK(BM_ReplacePage)->ArgsProduct({{4, 5, 6, 7, 8}, {0}, {16, 256, 4096}});
+BENCHMARK(BM_FreeMemoryAddresses)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_RunProgram)->Arg(64)->Arg(4096);
+BENCHMARK(BM_PrintStatus)->ArgsProduct({{0, 1, 2}, {16, 256, 4096}});
+BENCHMARK(BM_Workload)->ArgsProduct({{0, 1, 2, 3}, {0, 1, 2}, {16, 64}})->Unit(benchmark::kMillisecond);
+// OPT는 사전 실행의 참조 스트림이 있어야 하므로 워크로드 단위로만 측정 (사전 실행 시간 포함)
+BENCHMARK(BM_WorkloadPattern)->ArgsProduct({{0, 1, 2, 3, 4}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}})->Unit(benchmark::kMillisecond);
+
+int main(int argc, char* argv[]) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    if (!generated_workload_directory.empty()) {
+        std::filesystem::remove_all(generated_workload_directory);
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "Stats.hpp"
+#include "System.hpp"
+
+stats_format str_to_stats_format(const std::string& format_str) {
+    if (format_str == JSON_STATS_STRING) return Json_stats;
+    if (format_str == CSV_STATS_STRING) return Csv_stats;
+
+    fprintf(stderr, "Argument does not match statistics format\n");
+    throw;
+}
+
+std::string stats_format_to_str(stats_format format) {
+    switch (format) {
+        case Csv_stats:
+            return CSV_STATS_STRING;
+        default:
+            return JSON_STATS_STRING;
+    }
+}
+
+static const std::string& system_call_type_to_str(int type) {
+    static const std::string names[SYSTEM_CALL_TYPE_COUNT] = {
+            SLEEP_COMMAND_STRING, WAIT_COMMAND_STRING, FORK_AND_EXEC_COMMAND_STRING,
+            EXIT_COMMAND_STRING, MEMORY_ALLOCATE_COMMAND_STRING, MEMORY_RELEASE_COMMAND_STRING,
+    };
+    return names[type];
+}
+
+void Histogram::add(long long value) {
+    size_t bucket = 0;
+    while (bucket < 63 && bucket_upper_bound(bucket) < value) bucket++;
+    if (buckets.size() <= bucket) buckets.resize(bucket + 1, 0);
+    buckets[bucket]++;
+    count++;
+    sum += value;
+    if (value > max) max = value;
+}
+
+static void write_json_histogram(FILE* out, const Histogram& histogram) {
+    fprintf(out, "{\"count\": %lld, \"sum\": %lld, \"max\": %lld, \"buckets\": [",
+            histogram.count, histogram.sum, histogram.max);
+    for (size_t i = 0; i < histogram.buckets.size(); i++) {
+        fprintf(out, "%s{\"le\": %lld, \"count\": %lld}", i == 0 ? "" : ", ",
+                Histogram::bucket_upper_bound(i), histogram.buckets[i]);
+    }
+    fprintf(out, "]}");
+}
+
+static void write_csv_histogram(FILE* out, const std::string& name, const Histogram& histogram) {
+    fprintf(out, "histogram,%s,count,%lld\n", name.c_str(), histogram.count);
+    fprintf(out, "histogram,%s,sum,%lld\n", name.c_str(), histogram.sum);
+    fprintf(out, "histogram,%s,max,%lld\n", name.c_str(), histogram.max);
+    for (size_t i = 0; i < histogram.buckets.size(); i++) {
+        fprintf(out, "histogram,%s,le_%lld,%lld\n", name.c_str(), Histogram::bucket_upper_bound(i),
+                histogram.buckets[i]);
+    }
+}
+
+void Statistics::write(FILE* out, stats_format format, const std::string& policy, int cycles) const {
+    const std::pair<const char*, long long> totals[] = {
+            {"cycles", cycles},
+            {"memory_hits", memory_hits},
+            {"page_faults", page_faults},
+            {"protection_faults", protection_faults},
+            {"evictions", evictions},
+            {"swap_ins", swap_ins},
+            {"swap_outs", swap_outs},
+            {"peak_swap_size", (long long) peak_swap_size},
+            {"protection_fault_copies", protection_fault_copies},
+            {"exit_copies", exit_copies},
+            {"memory_release_copies", memory_release_copies},
+    };
+    const std::pair<const char*, const WallTimer*> timers[] = {
+            {"replace_page", &replace_page_timer},
+            {"run_program", &run_program_timer},
+            {"print_status", &print_status_timer},
+    };
+
+    if (format == Csv_stats) {
+        fprintf(out, "section,name,field,value\n");
+        fprintf(out, "summary,,policy,%s\n", policy.c_str());
+        for (const auto& total: totals) {
+            fprintf(out, "summary,,%s,%lld\n", total.first, total.second);
+        }
+        for (const auto& entry: processes) {
+            fprintf(out, "process,%d(%s),page_faults,%lld\n", entry.first, entry.second.name.c_str(),
+                    entry.second.page_faults);
+            fprintf(out, "process,%d(%s),protection_faults,%lld\n", entry.first, entry.second.name.c_str(),
+                    entry.second.protection_faults);
+        }
+        write_csv_histogram(out, "ready_queue_length", ready_queue_length);
+        write_csv_histogram(out, "waiting_queue_length", waiting_queue_length);
+        for (int type = 0; type < SYSTEM_CALL_TYPE_COUNT; type++) {
+            write_csv_histogram(out, "syscall_latency." + system_call_type_to_str(type), syscall_latency[type]);
+        }
+        if (timers_enabled) {
+            for (const auto& timer: timers) {
+                fprintf(out, "timer,%s,calls,%lld\n", timer.first, timer.second->calls);
+                fprintf(out, "timer,%s,nanoseconds,%lld\n", timer.first, timer.second->nanoseconds);
+            }
+        }
+        return;
+    }
+
+    fprintf(out, "{\n  \"policy\": \"%s\",\n", policy.c_str());
+    for (const auto& total: totals) {
+        fprintf(out, "  \"%s\": %lld,\n", total.first, total.second);
+    }
+
+    fprintf(out, "  \"processes\": [");
+    bool first = true;
+    for (const auto& entry: processes) {
+        fprintf(out, "%s\n    {\"pid\": %d, \"name\": \"%s\", \"page_faults\": %lld, \"protection_faults\": %lld}",
+                first ? "" : ",", entry.first, entry.second.name.c_str(), entry.second.page_faults,
+                entry.second.protection_faults);
+        first = false;
+    }
+    fprintf(out, "%s],\n", processes.empty() ? "" : "\n  ");
+
+    fprintf(out, "  \"ready_queue_length\": ");
+    write_json_histogram(out, ready_queue_length);
+    fprintf(out, ",\n  \"waiting_queue_length\": ");
+    write_json_histogram(out, waiting_queue_length);
+    fprintf(out, ",\n  \"syscall_latency\": {");
+    for (int type = 0; type < SYSTEM_CALL_TYPE_COUNT; type++) {
+        fprintf(out, "%s\n    \"%s\": ", type == 0 ? "" : ",", system_call_type_to_str(type).c_str());
+        write_json_histogram(out, syscall_latency[type]);
+    }
+    fprintf(out, "\n  }");
+
+    if (timers_enabled) {
+        fprintf(out, ",\n  \"timers\": {");
+        for (size_t i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) {
+            fprintf(out, "%s\n    \"%s\": {\"calls\": %lld, \"nanoseconds\": %lld}", i == 0 ? "" : ",",
+                    timers[i].first, timers[i].second->calls, timers[i].second->nanoseconds);
+        }
+        fprintf(out, "\n  }");
+    }
+    fprintf(out, "\n}\n");
+}
@@ -0,0 +1,135 @@
+#ifndef HW3_STATS_HPP
+#define HW3_STATS_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include "Syscall.hpp"
+
+enum stats_format {
+    Json_stats,
+    Csv_stats,
+};
+
+const std::string JSON_STATS_STRING = "json";
+const std::string CSV_STATS_STRING = "csv";
+
+stats_format str_to_stats_format(const std::string& format_str);
+std::string stats_format_to_str(stats_format format);
+
+/**
+ * 2의 거듭제곱 구간 히스토그램\n
+ * 0번 구간은 0, i번 구간은 [2^(i-1), 2^i) 값을 센다.
+ */
+struct Histogram {
+    std::vector<long long> buckets;
+    long long count = 0;
+    long long sum = 0;
+    long long max = 0;
+
+    void add(long long value);
+
+    /**
+     * i번 구간에 들어가는 가장 큰 값
+     */
+    static long long bucket_upper_bound(size_t i) {
+        return i == 0 ? 0 : (1LL << i) - 1;
+    }
+};
+
+/**
+ * 벽시계 시간 누적 타이머
+ */
+struct WallTimer {
+    long long calls = 0;
+    long long nanoseconds = 0;
+};
+
+/**
+ * 범위를 벗어날 때 걸린 시간을 WallTimer에 더함 (timer가 nullptr이면 아무것도 하지 않음)
+ */
+class ScopedTimer {
+private:
+    WallTimer* timer;
+    std::chrono::steady_clock::time_point begin;
+
+public:
+    explicit ScopedTimer(WallTimer* timer) : timer(timer) {
+        if (timer != nullptr) begin = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer() {
+        if (timer == nullptr) return;
+        timer->calls++;
+        timer->nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count();
+    }
+};
+
+/**
+ * 프로세스별 폴트 횟수
+ */
+struct ProcessStats {
+    std::string name;
+    long long page_faults = 0;
+    long long protection_faults = 0;
+};
+
+const int SYSTEM_CALL_TYPE_COUNT = Memory_release + 1;
+
+/**
+ * 한 번의 실행 동안 모으는 통계
+ */
+struct Statistics {
+    // memory_read/memory_write 중 물리 메모리에 있던 접근 (적중), 없던 접근은 page_faults
+    long long memory_hits = 0;
+    long long page_faults = 0;
+    long long protection_faults = 0;
+    long long evictions = 0;
+    // 스왑 영역 -> 물리 메모리, 물리 메모리 -> 스왑 영역
+    long long swap_ins = 0;
+    long long swap_outs = 0;
+    size_t peak_swap_size = 0;
+    // CoW로 공유하던 페이지를 복사한 횟수 (복사가 일어난 곳별)
+    long long protection_fault_copies = 0;
+    long long exit_copies = 0;
+    long long memory_release_copies = 0;
+    std::map<int, ProcessStats> processes; // pid -> 통계
+
+    // 스케쥴할 때의 ready queue, waiting queue 길이
+    Histogram ready_queue_length;
+    Histogram waiting_queue_length;
+    // 시스템 콜을 호출한 cycle부터 그 프로세스가 다시 스케쥴될 때까지의 cycle 수 (exit은 종료 처리될 때까지)
+    Histogram syscall_latency[SYSTEM_CALL_TYPE_COUNT];
+
+    bool timers_enabled = false;
+    WallTimer replace_page_timer;
+    WallTimer run_program_timer;
+    WallTimer print_status_timer;
+
+    /**
+     * 타이머가 켜져 있을 때만 타이머를 돌려줌 (ScopedTimer에 넘김)
+     */
+    WallTimer* timer(WallTimer& wall_timer) {
+        return timers_enabled ? &wall_timer : nullptr;
+    }
+
+    ProcessStats& process(int pid, const std::string& name) {
+        ProcessStats& stats = processes[pid];
+        if (stats.name.empty()) stats.name = name;
+        return stats;
+    }
+
+    /**
+     * 통계 출력
+     * @param out 출력 파일
+     * @param format 출력 형식
+     * @param policy 페이지 교체 알고리즘 이름
+     * @param cycles 실행한 cycle 수
+     */
+    void write(FILE* out, stats_format format, const std::string& policy, int cycles) const;
+};
+
+#endif //HW3_STATS_HPP
@@ -0,0 +1,66 @@
+#include "Swap.hpp"
+#include "System.hpp"
+
+// 빈 slot 수가 이 값과 남은 프레임 수를 모두 넘으면 정리
+const size_t SWAP_COMPACT_THRESHOLD = 64;
+
+void SwapSpace::push_back(PhysicalFrame* frame) {
+    // 이미 같은 키가 있으면 먼저 들어온 프레임을 색인에 유지
+    if (!this->index.emplace(key(frame->process_id, frame->page_id), this->slots.size()).second) {
+        this->has_duplicate = true;
+    }
+    this->slots.push_back(frame);
+    this->live++;
+    if (this->live > this->peak) this->peak = this->live;
+}
+
+PhysicalFrame* SwapSpace::find(int process_id, int page_id) const {
+    auto it = this->index.find(key(process_id, page_id));
+    if (it == this->index.end()) return nullptr;
+    return this->slots[it->second];
+}
+
+PhysicalFrame* SwapSpace::take(int process_id, int page_id) {
+    auto it = this->index.find(key(process_id, page_id));
+    if (it == this->index.end()) return nullptr;
+
+    size_t slot = it->second;
+    PhysicalFrame* frame = this->slots[slot];
+    this->slots[slot] = nullptr;
+    this->index.erase(it);
+    this->live--;
+
+    // 같은 키의 다음 프레임을 색인에 등록
+    if (this->has_duplicate) {
+        for (size_t i = slot + 1; i < this->slots.size(); i++) {
+            PhysicalFrame* other = this->slots[i];
+            if (other != nullptr && other->process_id == process_id && other->page_id == page_id) {
+                this->index.emplace(key(process_id, page_id), i);
+                break;
+            }
+        }
+    }
+
+    size_t empty_slots = this->slots.size() - this->live;
+    if (empty_slots > SWAP_COMPACT_THRESHOLD && empty_slots > this->live) {
+        this->compact();
+    }
+    return frame;
+}
+
+void SwapSpace::compact() {
+    size_t next = 0;
+    for (PhysicalFrame* frame: this->slots) {
+        if (frame != nullptr) this->slots[next++] = frame;
+    }
+    this->slots.resize(next);
+
+    this->index.clear();
+    this->has_duplicate = false;
+    for (size_t i = 0; i < this->slots.size(); i++) {
+        PhysicalFrame* frame = this->slots[i];
+        if (!this->index.emplace(key(frame->process_id, frame->page_id), i).second) {
+            this->has_duplicate = true;
+        }
+    }
+}
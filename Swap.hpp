@@ -0,0 +1,82 @@
+#ifndef HW3_SWAP_HPP
+#define HW3_SWAP_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+struct PhysicalFrame;
+
+/**
+ * 스왑 영역\n
+ * 프레임은 들어온 순서대로 slot에 저장되고 (process_id, page_id)로 색인되어
+ * 삽입, 검색, 삭제가 모두 O(1)이다. 삭제된 slot은 비워 두었다가 빈 slot이 많아지면 한 번에 정리하므로
+ * 남아 있는 프레임의 순서는 항상 들어온 순서와 같다.
+ */
+class SwapSpace {
+private:
+    std::vector<PhysicalFrame*> slots;
+    std::unordered_map<uint64_t, size_t> index;
+    size_t live = 0;
+    size_t peak = 0;
+    // 같은 (process_id, page_id)를 가진 프레임이 들어온 적이 있는지
+    bool has_duplicate = false;
+
+    static uint64_t key(int process_id, int page_id) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(process_id)) << 32) | static_cast<uint32_t>(page_id);
+    }
+
+    /**
+     * 빈 slot을 제거하고 색인을 다시 만든다
+     */
+    void compact();
+
+public:
+    /**
+     * 프레임을 스왑 영역 끝에 추가
+     * @param frame 추가할 프레임
+     */
+    void push_back(PhysicalFrame* frame);
+
+    /**
+     * (process_id, page_id)에 해당하는 프레임 검색, 여러 개라면 가장 먼저 들어온 프레임
+     * @return 프레임, 없으면 nullptr
+     */
+    PhysicalFrame* find(int process_id, int page_id) const;
+
+    /**
+     * (process_id, page_id)에 해당하는 프레임을 스왑 영역에서 빼냄
+     * @return 빠진 프레임, 없으면 nullptr
+     */
+    PhysicalFrame* take(int process_id, int page_id);
+
+    void reserve(size_t capacity) {
+        slots.reserve(capacity);
+        index.reserve(capacity);
+    }
+
+    size_t size() const {
+        return live;
+    }
+
+    /**
+     * 지금까지 스왑 영역에 가장 많이 들어 있던 프레임 수
+     */
+    size_t peak_size() const {
+        return peak;
+    }
+
+    /**
+     * 들어온 순서대로 프레임 순회
+     * @param visit 각 프레임마다 호출할 함수
+     */
+    template<typename Visitor>
+    void for_each(Visitor visit) const {
+        for (PhysicalFrame* frame: slots) {
+            if (frame != nullptr) visit(frame);
+        }
+    }
+};
+
+#endif //HW3_SWAP_HPP
@@ -0,0 +1,109 @@
+#include "Sweep.hpp"
+#include "Run.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+
+const std::string SWEEP_SUMMARY_FILENAME = "summary";
+
+/**
+ * 결과 파일 이름에 쓸 디렉토리 이름 (마지막 경로 요소)
+ */
+static std::string directory_label(const std::string& directory) {
+    std::filesystem::path path(directory);
+    if (!path.has_filename()) path = path.parent_path();
+    std::string label = path.filename().string();
+    return label.empty() ? "programs" : label;
+}
+
+std::vector<SweepResult> sweep(const SweepOptions& options) {
+    std::vector<int> physical_memory_sizes = options.physical_memory_sizes;
+    if (physical_memory_sizes.empty()) {
+        physical_memory_sizes.push_back(options.geometry.physical_memory_size);
+    }
+
+    std::filesystem::create_directories(options.output_directory);
+
+    // 이름이 같은 디렉토리가 있으면 순번을 붙여 결과 파일이 겹치지 않게 한다
+    std::vector<std::string> labels;
+    std::unordered_set<std::string> used_labels;
+    for (size_t i = 0; i < options.directories.size(); i++) {
+        std::string label = directory_label(options.directories[i]);
+        if (!used_labels.insert(label).second) {
+            label += "-" + std::to_string(i);
+            used_labels.insert(label);
+        }
+        labels.push_back(label);
+    }
+
+    std::vector<SweepResult> results;
+    for (size_t i = 0; i < options.directories.size(); i++) {
+        for (int physical_memory_size: physical_memory_sizes) {
+            for (const auto& policy: options.policies) {
+                SweepResult result;
+                result.directory = options.directories[i];
+                result.policy = policy;
+                result.physical_memory_size = physical_memory_size;
+                result.result_filename = options.output_directory + "/" + labels[i] + "-" + policy + "-"
+                                         + std::to_string(physical_memory_size)
+                                         + (options.mode == Binary_trace ? ".bin" : "");
+                results.push_back(result);
+            }
+        }
+    }
+
+    // 결과 벡터의 크기는 고정되어 있으므로 각 작업은 자기 칸에만 쓴다
+    WorkStealingPool pool(options.jobs);
+    for (auto& result: results) {
+        pool.submit([&options, &result]() {
+            MemoryGeometry geometry = options.geometry;
+#ifndef FIXED_GEOMETRY
+            geometry.physical_memory_size = result.physical_memory_size;
+#endif
+            Simulator sim;
+            if (options.write_stats) {
+                sim.stats_filename = result.result_filename + ".stats." + stats_format_to_str(options.stats_mode);
+                sim.stats_mode = options.stats_mode;
+            }
+            sim.timers_enabled = options.timers_enabled;
+            run(sim, result.directory + "/", result.policy, result.result_filename, options.mode, options.search,
+                geometry);
+            result.cycles = sim.status.cycle;
+            result.memory_hits = (int) sim.status.stats.memory_hits;
+            result.page_faults = (int) sim.status.stats.page_faults;
+            result.protection_faults = (int) sim.status.stats.protection_faults;
+            result.evictions = (int) sim.status.stats.evictions;
+        });
+    }
+    pool.run();
+
+    FILE* summary = fopen((options.output_directory + "/" + SWEEP_SUMMARY_FILENAME).c_str(), "w");
+    if (summary != nullptr) {
+        print_sweep_summary(results, summary);
+        fclose(summary);
+    }
+    return results;
+}
+
+void print_sweep_summary(const std::vector<SweepResult>& results, FILE* out) {
+    int directory_width = (int) std::string("directory").size();
+    int policy_width = (int) std::string("policy").size();
+    for (const auto& result: results) {
+        directory_width = std::max(directory_width, (int) result.directory.size());
+        policy_width = std::max(policy_width, (int) result.policy.size());
+    }
+
+    fprintf(out, "%-*s  %-*s  %15s  %10s  %11s  %11s  %10s  %17s  %9s\n", directory_width, "directory",
+            policy_width, "policy", "physical_memory", "cycles", "memory_hits", "page_faults", "fault_rate",
+            "protection_faults", "evictions");
+    for (const auto& result: results) {
+        // 페이지 폴트 비율 = 폴트 / (적중 + 폴트), 정책끼리 같은 워크로드에서 비교
+        int references = result.memory_hits + result.page_faults;
+        double fault_rate = references > 0 ? (double) result.page_faults / references : 0.0;
+        fprintf(out, "%-*s  %-*s  %15d  %10d  %11d  %11d  %10.4f  %17d  %9d\n", directory_width,
+                result.directory.c_str(), policy_width, result.policy.c_str(), result.physical_memory_size,
+                result.cycles, result.memory_hits, result.page_faults, fault_rate, result.protection_faults,
+                result.evictions);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef HW3_SWEEP_HPP
+#define HW3_SWEEP_HPP
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "System.hpp"
+#include "Trace.hpp"
+
+/**
+ * 파라미터 스윕 설정 (디렉토리 x 물리 메모리 크기 x 교체 알고리즘의 모든 조합을 실행)
+ */
+struct SweepOptions {
+    std::vector<std::string> directories;
+    std::vector<std::string> policies = {FIFO_STRING, LRU_STRING, LFU_STRING, MFU_STRING};
+    // 비어 있으면 geometry의 물리 메모리 크기만 사용
+    std::vector<int> physical_memory_sizes;
+    // 물리 메모리 크기를 제외한 나머지 메모리 구성
+    MemoryGeometry geometry;
+    trace_mode mode = Text_trace;
+    victim_search search = Indexed_victim_search;
+    // 실행별 결과 파일과 요약표를 쓰는 디렉토리
+    std::string output_directory = "sweep";
+    // 워커 스레드 수 (0 이하이면 하드웨어 스레드 수)
+    int jobs = 0;
+    // 실행별 통계 파일 (결과 파일 이름 뒤에 .stats.json/.stats.csv)
+    bool write_stats = false;
+    stats_format stats_mode = Json_stats;
+    bool timers_enabled = false;
+};
+
+/**
+ * 스윕 실행 하나의 결과
+ */
+struct SweepResult {
+    std::string directory;
+    std::string policy;
+    int physical_memory_size;
+    std::string result_filename;
+    int cycles = 0;
+    int memory_hits = 0;
+    int page_faults = 0;
+    int protection_faults = 0;
+    int evictions = 0;
+};
+
+/**
+ * 모든 조합을 work stealing 스레드 풀에서 실행
+ * @param options 스윕 설정
+ * @return 실행 결과 (디렉토리, 물리 메모리 크기, 교체 알고리즘 순)
+ */
+std::vector<SweepResult> sweep(const SweepOptions& options);
+
+/**
+ * 스윕 결과 요약표 출력
+ * @param results 스윕 결과
+ * @param out 출력 파일
+ */
+void print_sweep_summary(const std::vector<SweepResult>& results, FILE* out);
+
+#endif //HW3_SWEEP_HPP
@@ -5,49 +5,57 @@
 #include "Syscall.hpp"
 #include "System.hpp"
 #include "Run.hpp"
-#include <algorithm>
-#include <unordered_set>
 
-using namespace Run;
-
-void sleep(int sleep_time) {
+void sleep(Simulator &sim, int sleep_time) {
+    Status &status = sim.status;
     Process *p = status.process_running;
     p->state = Waiting;
-    p->remain_sleep_time = sleep_time - 1;
+    int remain_sleep_time = sleep_time - 1;
 
-    if (p->remain_sleep_time == 0) {
+    if (remain_sleep_time == 0) {
         status.process_ready.push_back(p);
         p->state = Ready;
     } else {
         status.process_waiting.push_back(p);
         p->waiting_type = 'S';
+        // remain_sleep_time번의 update() 후에 깨어남 (음수이면 기존 동작처럼 깨어나지 않음)
+        if (remain_sleep_time > 0) {
+            status.process_sleeping.schedule(status.tick + remain_sleep_time, p);
+        }
     }
 
     status.process_running = nullptr;
 }
 
-void fork_and_exec(std::string program_name) {
+void fork_and_exec(Simulator &sim, int program_id) {
+    Status &status = sim.status;
     Process *p = status.process_running;
 
-    auto *new_process = new Process(std::move(program_name), status.process_num + 1, p->pid, New,
+    const ProgramImage *image = sim.programs.load(program_id);
+    auto *new_process = status.process_pool.create(image->name, status.process_num + 1, p->pid, status.geometry, New,
                                     p->next_allocation_id, p->next_page_id);
+    new_process->image = image;
     status.process_new = new_process;
 
     // 부모 프로세스의 페이지 및 가상 메모리 CoW 형식으로 복사
-    for (int address = 0; address < VIRTUAL_MEMORY_SIZE; address++) {
+    for (int address = 0; address < status.geometry.virtual_memory_size; address++) {
 
         const auto &parent_pe = p->page_table[address];
         if (parent_pe == nullptr) continue;
         // 가상 메모리 복사
-        new_process->virtual_memory[address] = p->virtual_memory[address];
+        new_process->map_page(address, p->virtual_memory[address]);
 
         // 부모 프로세스의 페이지도 읽기 권한으로 변경
         parent_pe->authority = 'R';
-        // 페이지 테이블 엔트리 복사됨
-        new_process->page_table[address] = p->page_table[address];
+        // 페이지 테이블 엔트리 공유
+        new_process->page_table[address] = parent_pe;
+        status.page_sharers.share(parent_pe, new_process);
     }
+    // 같은 가상 메모리 주소에 공유하므로 할당별 주소도 그대로 물려받음
+    new_process->allocation_addresses = p->allocation_addresses;
 
     status.process_num++;
+    status.processes.add(new_process);
 
     // 부모 프로세스는 다시 Ready
     status.process_ready.push_back(p);
@@ -55,36 +63,16 @@ void fork_and_exec(std::string program_name) {
     status.process_running = nullptr;
 }
 
-void wait() {
+void wait(Simulator &sim) {
+    Status &status = sim.status;
     Process *p = status.process_running;
 
-    bool exist_child_process = false;
-
-    // new process 검사
-    if (status.process_new != nullptr) {
-        if (status.process_new->ppid == p->pid) {
-            exist_child_process = true;
-        }
-    }
-
-    // waiting queue 검사
-    for (Process *wp: status.process_waiting) {
-        if (wp->ppid == p->pid) {
-            exist_child_process = true;
-            break;
-        }
-    }
-
-    // ready queue 검사
-    for (Process *rp: status.process_ready) {
-        if (rp->ppid == p->pid) {
-            exist_child_process = true;
-            break;
-        }
-    }
+    // new, ready, waiting 상태인 자식 프로세스가 있는지
+    bool exist_child_process = p->first_child != nullptr;
 
     if (exist_child_process) {
         status.process_waiting.push_back(p);
+        status.process_waiting_for_child[p->pid] = p;
         p->state = Waiting;
         p->waiting_type = 'W';
     } else {
@@ -96,138 +84,144 @@ void wait() {
     status.process_running = nullptr;
 }
 
-void exit() {
+void exit(Simulator &sim) {
+    Status &status = sim.status;
     Process *p = status.process_running;
 
     p->state = Terminated;
 
+    status.processes.remove(p);
+
     // waiting 하고 있는 부모 프로세스의 상태를 Ready로 변경
-    for (auto it = status.process_waiting.begin(); it != status.process_waiting.end(); ++it) {
-        auto pp = *it;
-        if (p->ppid == pp->pid) {
-            if (pp->waiting_type == 'W') {
-                pp->state = Ready;
-                pp->waiting_type = '\0';
-                status.process_ready.push_back(pp);
-                break;
-            }
-        }
+    auto waiting_parent = status.process_waiting_for_child.find(p->ppid);
+    if (waiting_parent != status.process_waiting_for_child.end()) {
+        Process *pp = waiting_parent->second;
+        status.process_waiting_for_child.erase(waiting_parent);
+        status.process_waiting.remove(pp);
+        pp->state = Ready;
+        pp->waiting_type = '\0';
+        status.process_ready.push_back(pp);
     }
 
-    // Ready Queue에 들어간 프로세스들을 wating queue에서 제거
-    auto it = std::remove_if(status.process_waiting.begin(), status.process_waiting.end(),
-                             [](Process *p) { return p->state == Ready; });
-    status.process_waiting.erase(it, status.process_waiting.end());
-
-    // 공유하고 있는 page id를 기록 => 다른 프로세스들에서 공유하고 있던 페이지를 복사하기 위해
-    std::unordered_set<int> shared_page_ids;
+    // 공유하고 있던 (가상 메모리 주소, 페이지 테이블 엔트리) => 같은 엔트리를 공유하는 프로세스들에 페이지를 복사하기 위해
+    std::vector<std::pair<int, PageTableEntry*>> shared_pages;
 
     // 해당 프로세스에 할당된 물리 메모리를 모두 해제
-    for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
+    for (int i = 0; i < status.geometry.virtual_memory_size; i++) {
         if (p->virtual_memory[i] == -1) continue;
-        PhysicalFrame** target_frame;
         auto &pe = p->page_table[i];
 
         int target_frame_pid = p->pid;
         if (pe->authority == 'R' && p->pid != 1) target_frame_pid = p->ppid;
 
-        if (pe->physical_address == -1) {
-            // 스왑 영역에 있는 경우
-            for (auto &frame_in_swap_space: status.swap_space) {
-                if (frame_in_swap_space == nullptr) continue;
-                if (frame_in_swap_space->process_id == target_frame_pid && frame_in_swap_space->page_id == p->virtual_memory[i]) {
-                    target_frame = &frame_in_swap_space;
-                    break;
-                }
-            }
-        } else {
-            // 물리 메모리에 있는 경우
-            target_frame = &status.physical_memory[pe->physical_address];
-        }
         // 쓰기 권한까지 있을 떄 물리 메모리에서 제거
         if (pe->authority == 'W' || p->pid == 1) {
-            delete (*target_frame);
-            (*target_frame) = nullptr;
-            delete pe;
+            if (pe->physical_address == -1) {
+                // 스왑 영역에 있는 경우
+                status.frame_pool.destroy(status.swap_space.take(target_frame_pid, p->virtual_memory[i]));
+            } else {
+                // 물리 메모리에 있는 경우
+                status.release_frame(pe->physical_address);
+            }
+            status.destroy_page_entry(pe);
         } else {
-            shared_page_ids.insert(p->virtual_memory[i]);
+            status.page_sharers.unshare(pe, p);
+            shared_pages.emplace_back(i, pe);
         }
         pe = nullptr;
     }
 
-    // 스왑 영역에서 nullptr이거 된 프레임 제거
-    const auto swap_it = std::remove_if(status.swap_space.begin(), status.swap_space.end(),
-                                        [](const auto &frame) { return frame == nullptr; });
-    status.swap_space.erase(swap_it, status.swap_space.end());
-
-    // 해제한 메모리를 공유하고 있는 자식 모두에 프로세스에 페이지 및 프레임 복사
-    auto child_processes = status.get_child_processes(1);
-
-    for (auto &child: child_processes) {
-        if (child->pid == p->pid) continue;
-        for (int virtual_address = 0; virtual_address < VIRTUAL_MEMORY_SIZE; virtual_address++) {
-            if (child->virtual_memory[virtual_address] == -1) continue;
-            int current_page_id = child->virtual_memory[virtual_address];
+    // 해제한 메모리를 공유하고 있는 init의 자식 프로세스 모두에 페이지 및 프레임 복사
+    // 같은 엔트리를 공유하는 프로세스만 확인 (fork는 엔트리를 같은 가상 메모리 주소에 공유함)
+    for (const auto &shared_page: shared_pages) {
+        int virtual_address = shared_page.first;
+        PageTableEntry *shared_pe = shared_page.second;
+        if (status.page_sharers.count(shared_pe) == 0) continue;
+        auto sharers = status.page_sharers.of(shared_pe);
+        for (auto &child: sharers) {
+            if (child->ppid != 1) continue;
             auto &pe = child->page_table[virtual_address];
-            if (pe == nullptr) continue;
+            if (pe != shared_pe) continue;
             // 공유하고 있던 페이지를(read 권한만 있던) 부모 페이지로부터 복사 (write 권한을 부여 하고 스왑 영역에 생성)
-            if ((shared_page_ids.find(current_page_id) != shared_page_ids.end()) &&
-                pe->authority == 'R') {
-                // 복사하고 스왑영역에 넣어 놓기
-                pe = new PageTableEntry(-1, pe->allocation_id);
-                status.swap_space.push_back(new PhysicalFrame(child->pid,
-                                                              child->virtual_memory[virtual_address],
-                                                              status.top_fi_score++));
-                status.swap_space.back()->linked_page = pe;
-            }
+            // 복사하고 스왑영역에 넣어 놓기
+            status.page_sharers.unshare(pe, child);
+            pe = status.page_pool.create(-1, pe->allocation_id);
+            status.page_sharers.share(pe, child);
+            auto *copied_frame = status.frame_pool.create(child->pid, child->virtual_memory[virtual_address],
+                                                   status.top_fi_score++);
+            copied_frame->linked_page = pe;
+            status.swap_space.push_back(copied_frame);
+            status.stats.exit_copies++;
         }
     }
     // 해제하는 페이지가 부모 프로세스의 페이지가 아닌 경우 부모 프로세스의 해당 페이지의 권한을 W권한으로 바꿔준다.
     if (p->pid != 1) {
         auto* init_process = status.get_process_by_pid(1);
 
-        for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
-            if (init_process->virtual_memory[i] == -1) continue;
-            int current_page_id = init_process->virtual_memory[i];
-            auto& pe = init_process->page_table[current_page_id];
+        for (const auto &shared_page: shared_pages) {
+            int shared_page_id = p->virtual_memory[shared_page.first];
+            int init_virtual_address = init_process->virtual_address_of(shared_page_id);
+            if (init_virtual_address == -1) continue;
+            auto& pe = init_process->page_table[init_virtual_address];
             if (pe == nullptr) continue;
 
-            if (shared_page_ids.find(current_page_id) != shared_page_ids.end()) {
-                pe->authority = 'W';
-            }
+            pe->authority = 'W';
         }
     }
 
+    // exit을 호출한 프로세스는 다시 스케쥴되지 않으므로 종료 처리된 cycle까지를 기록
+    if (p->syscall_cycle != -1) {
+        status.stats.syscall_latency[Exit].add(status.cycle - p->syscall_cycle);
+        p->syscall_cycle = -1;
+    }
+
     status.process_running = nullptr;
     status.process_terminated = p;
 }
 
-void boot() {
-    status.command = BOOT_COMMAND_STRING;
-    auto *init = new Process("init", 1, 0);
+void boot(Simulator &sim) {
+    Status &status = sim.status;
+    status.command = &BOOT_COMMAND_STRING;
+    status.task = Boot_task;
+    auto *init = status.process_pool.create("init", 1, 0, status.geometry);
+    init->image = sim.programs.load(init->name);
     status.process_new = init;
     status.process_num++;
+    status.processes.add(init);
 }
 
-void schedule() {
-    status.command = SCHEDULE_COMMAND_STRING;
+void schedule(Simulator &sim) {
+    Status &status = sim.status;
+    status.command = &SCHEDULE_COMMAND_STRING;
+    status.task = Schedule_task;
+    status.stats.ready_queue_length.add((long long) status.process_ready.size());
+    status.stats.waiting_queue_length.add((long long) status.process_waiting.size());
     Process *p = status.process_ready.front();
     p->state = Running;
 
+    // 시스템 콜을 호출한 뒤 다시 스케쥴되기까지 걸린 cycle
+    if (p->syscall_cycle != -1) {
+        status.stats.syscall_latency[p->pending_syscall].add(status.cycle - p->syscall_cycle);
+        p->syscall_cycle = -1;
+    }
+
     // running process로 바꾸고 ready queue에서 지운다.
     status.process_running = p;
-    status.process_ready.erase(status.process_ready.begin());
+    status.process_ready.pop_front();
 }
 
-void schedule_or_idle() {
+void schedule_or_idle(Simulator &sim) {
+    Status &status = sim.status;
     if (!status.process_ready.empty()) {
-        schedule();
+        schedule(sim);
     } else {
-        status.command = IDLE_COMMAND_STRING;
+        status.command = &IDLE_COMMAND_STRING;
+        status.task = Idle_task;
     }
 }
 
-void memory_allocate(int allocation_size) {
+void memory_allocate(Simulator &sim, int allocation_size) {
+    Status &status = sim.status;
 
     Process *p = status.process_running;
 
@@ -244,7 +238,7 @@ void memory_allocate(int allocation_size) {
     }
 
     // 할당될 가상 메모리 공간 찾기
-    for (int i = 0; i < VIRTUAL_MEMORY_SIZE; i++) {
+    for (int i = 0; i < status.geometry.virtual_memory_size; i++) {
         bool can_allocate = true;
         for (size_t j = i; j < i + allocation_size; j++) {
             if (p->virtual_memory[j] != -1) {
@@ -256,7 +250,7 @@ void memory_allocate(int allocation_size) {
         allocate_begin_index = i;
         // 가상 메모리에 할당
         for (int j = i; j < i + allocation_size; j++) {
-            p->virtual_memory[j] = p->next_page_id + j - i;
+            p->map_page(j, p->next_page_id + j - i);
         }
         break;
     }
@@ -264,14 +258,16 @@ void memory_allocate(int allocation_size) {
 
     // 페이지 테이블 갱신 및 물리 메모리에 할당
     auto allocation_addresses_array = status.free_memory_addresses(allocation_size);
+    auto &allocated_virtual_addresses = p->allocation_addresses[p->next_allocation_id];
 
     for (const auto &address: allocation_addresses_array) {
-        p->page_table[allocate_begin_index] = new PageTableEntry(address,
+        allocated_virtual_addresses.push_back((int) allocate_begin_index);
+        p->page_table[allocate_begin_index] = status.page_pool.create(address,
                                                                  p->next_allocation_id);
-        status.physical_memory[address] = new PhysicalFrame(p->pid, p->next_page_id++,
-                                                            status.top_fi_score, 1, status.top_ru_score);
-
-        status.physical_memory[address]->linked_page = p->page_table[allocate_begin_index];
+        status.page_sharers.share(p->page_table[allocate_begin_index], p);
+        PhysicalFrame frame(p->pid, p->next_page_id++, status.top_fi_score, 1, status.top_ru_score);
+        frame.linked_page = p->page_table[allocate_begin_index];
+        status.place_frame(address, frame);
         allocate_begin_index++;
     }
 
@@ -284,24 +280,42 @@ void memory_allocate(int allocation_size) {
     status.process_running = nullptr;
 }
 
-void memory_release(int allocation_id) {
+/**
+ * 프로세스가 가진 allocation id의 페이지 가상 메모리 주소
+ * @param p 프로세스
+ * @param allocation_id allocation id
+ * @return 가상 메모리 주소 (오름차순), 없으면 빈 벡터
+ */
+static std::vector<int> addresses_of_allocation(const Process *p, int allocation_id) {
+    auto found = p->allocation_addresses.find(allocation_id);
+    if (found == p->allocation_addresses.end()) return {};
+    return found->second;
+}
+
+void memory_release(Simulator &sim, int allocation_id) {
+    Status &status = sim.status;
     Process *p = status.process_running;
+    auto* init_process = status.get_process_by_pid(1);
+
+    // 해제할 할당의 페이지만 확인 (init의 주소는 init의 페이지 테이블 엔트리를 정리할 때까지 필요)
+    std::vector<int> released_addresses = addresses_of_allocation(p, allocation_id);
+    std::vector<int> init_addresses = p->pid == 1 ? released_addresses
+                                                  : addresses_of_allocation(init_process, allocation_id);
+    p->allocation_addresses.erase(allocation_id);
 
     // 가상 메모리 및 물리 메모리에서 제거
-    for (int virtual_address = 0; virtual_address < VIRTUAL_MEMORY_SIZE; virtual_address++) {
+    for (int virtual_address: released_addresses) {
         auto &pe = p->page_table[virtual_address];
         if (pe == nullptr) continue;
         if (pe->allocation_id != allocation_id) continue;
 
         // 가상 메모리에서 페이지 제거
         int released_page_id = p->virtual_memory[virtual_address];
-        p->virtual_memory[virtual_address] = -1;
+        p->unmap_page(virtual_address);
 
 
         // 쓰기 권한까지 있을 때 혹은 init 프로세스일 때 물리 메모리에서 제거
         if (pe->authority == 'W' || p->pid == 1) {
-            PhysicalFrame **target_frame;
-
             int target_frame_pid = p->pid;
             if (pe->authority == 'R' && p->pid != 1) {
                 target_frame_pid = p->ppid;
@@ -310,68 +324,55 @@ void memory_release(int allocation_id) {
             // 메모리에서 해제할 프레임 찾기
             if (pe->physical_address == -1) {
                 // 스왑 영역에 있는 경우
-                for (auto &frame_in_swap_space: status.swap_space) {
-                    if (frame_in_swap_space == nullptr) continue;
-                    if (frame_in_swap_space->process_id == target_frame_pid &&
-                        frame_in_swap_space->page_id == released_page_id) {
-                        target_frame = &frame_in_swap_space;
-                        break;
-                    }
-                }
+                status.frame_pool.destroy(status.swap_space.take(target_frame_pid, released_page_id));
             } else {
-                target_frame = &status.physical_memory[pe->physical_address];
+                status.release_frame(pe->physical_address);
             }
-            delete (*target_frame);
-            (*target_frame) = nullptr;
-            if (pe->authority != 'R') delete pe;
+            if (pe->authority != 'R') status.destroy_page_entry(pe);
             else continue;
+        } else {
+            // 공유하던 페이지는 공유만 끊음
+            status.page_sharers.unshare(pe, p);
         }
         pe = nullptr;
     }
 
-    // 스왑 영역에서 nullptr이 된 프레임 제거
-    const auto swap_it = std::remove(status.swap_space.begin(), status.swap_space.end(),
-                                        nullptr);
-    status.swap_space.erase(swap_it, status.swap_space.end());
-
 
-
-    // 해제한 메모리를 공유하고 있는 자식 모두에 프로세스에 페이지 및 프레임 복사
-    auto child_processes = status.get_child_processes(1);
-
-    for (auto &child: child_processes) {
-        if (child->pid == p->pid) continue;
-        for (int virtual_address = 0; virtual_address < VIRTUAL_MEMORY_SIZE; virtual_address++) {
+    // 해제한 allocation id의 페이지를 읽기 권한으로 공유하고 있는 init의 자식 프로세스 모두에 페이지 및 프레임 복사
+    // init의 자식이 가진 읽기 권한 엔트리는 fork 때 init과 같은 가상 메모리 주소에 공유한 init의 엔트리이므로
+    // (CoW 복사가 일어나면 init과 자식 모두 공유가 끊김) init의 해당 할당 엔트리를 공유하는 프로세스만 확인하면 된다.
+    for (int virtual_address: init_addresses) {
+        PageTableEntry *shared_pe = init_process->page_table[virtual_address];
+        if (shared_pe == nullptr) continue;
+        if (shared_pe->allocation_id != allocation_id || shared_pe->authority != 'R') continue;
+        auto sharers = status.page_sharers.of(shared_pe);
+        for (auto &child: sharers) {
+            if (child->pid == p->pid || child->ppid != 1) continue;
             auto &pe = child->page_table[virtual_address];
-            if (pe == nullptr) continue;
+            if (pe != shared_pe) continue;
             // 공유하고 있던 페이지를(read 권한만 있던) 부모 페이지로부터 복사 (write 권한을 부여 하고 스왑 영역에 생성)
-            if (pe->allocation_id == allocation_id &&
-                pe->authority == 'R') {
-                // 복사하고 스왑영역에 넣어 놓기
-                pe = new PageTableEntry(-1, pe->allocation_id);
-                status.swap_space.push_back(new PhysicalFrame(child->pid,
-                                                              child->virtual_memory[virtual_address],
-                                                              status.top_fi_score++));
-                status.swap_space.back()->linked_page = pe;
-            }
+            // 복사하고 스왑영역에 넣어 놓기
+            status.page_sharers.unshare(pe, child);
+            pe = status.page_pool.create(-1, pe->allocation_id);
+            status.page_sharers.share(pe, child);
+            auto *copied_frame = status.frame_pool.create(child->pid, child->virtual_memory[virtual_address],
+                                                   status.top_fi_score++);
+            copied_frame->linked_page = pe;
+            status.swap_space.push_back(copied_frame);
+            status.stats.memory_release_copies++;
         }
     }
 
-    auto* init_process = status.get_process_by_pid(1);
-    if (p->pid != 1) {
-        // 해제하는 페이지가 부모 프로세스의 페이지가 아닌 경우 부모 프로세스의 해당 페이지의 권한을 W권한으로 바꿔준다.
-        for (auto& pe:init_process->page_table) {
-            if (pe == nullptr) continue;
-            if (pe->allocation_id == allocation_id) pe->authority = 'W';
-        }
-    } else {
-        // 해제하는 페이지가 부모 프로세스의 페이지인 경우 공유되는 페이지는 나중에 해제
-        for (auto& pe: init_process->page_table) {
-            if (pe == nullptr) continue;
-            if (pe->allocation_id == allocation_id) {
-                delete pe;
-                pe = nullptr;
-            }
+    for (int virtual_address: init_addresses) {
+        auto& pe = init_process->page_table[virtual_address];
+        if (pe == nullptr || pe->allocation_id != allocation_id) continue;
+        if (p->pid != 1) {
+            // 해제하는 페이지가 부모 프로세스의 페이지가 아닌 경우 부모 프로세스의 해당 페이지의 권한을 W권한으로 바꿔준다.
+            pe->authority = 'W';
+        } else {
+            // 해제하는 페이지가 부모 프로세스의 페이지인 경우 공유되는 페이지는 나중에 해제
+            status.destroy_page_entry(pe);
+            pe = nullptr;
         }
     }
 
@@ -383,48 +384,48 @@ void memory_release(int allocation_id) {
 }
 
 
-void system_call() {
-    int num_arg;
+void system_call(Simulator &sim) {
+    Status &status = sim.status;
     switch (status.syscall_type) {
         case Sleep:
-            num_arg = stoi(status.syscall_arg);
-            sleep(num_arg);
+            sleep(sim, status.syscall_arg);
             break;
         case Wait:
-            wait();
+            wait(sim);
             break;
         case Exit:
-            exit();
+            exit(sim);
             break;
         case Fork_and_exec:
-            fork_and_exec(status.syscall_arg);
+            fork_and_exec(sim, status.syscall_arg);
             break;
         case Memory_allocate:
-            num_arg = stoi(status.syscall_arg);
-            memory_allocate(num_arg);
+            memory_allocate(sim, status.syscall_arg);
             break;
         case Memory_release:
-            num_arg = stoi(status.syscall_arg);
-            memory_release(num_arg);
+            memory_release(sim, status.syscall_arg);
             break;
         default:
             break;
     }
 }
 
-system_call_type string_to_system_call_type(const std::string &str) {
-    if (str == SLEEP_COMMAND_STRING) {
-        return system_call_type::Sleep;
-    } else if (str == WAIT_COMMAND_STRING) {
-        return system_call_type::Wait;
-    } else if (str == EXIT_COMMAND_STRING) {
-        return system_call_type::Exit;
-    } else if (str == FORK_AND_EXEC_COMMAND_STRING) {
-        return system_call_type::Fork_and_exec;
-    } else if (str == MEMORY_ALLOCATE_COMMAND_STRING) {
-        return system_call_type::Memory_allocate;
-    } else if (str == MEMORY_RELEASE_COMMAND_STRING) {
-        return system_call_type::Memory_release;
+system_call_type opcode_to_system_call_type(opcode op) {
+    switch (op) {
+        case Op_sleep:
+            return system_call_type::Sleep;
+        case Op_wait:
+            return system_call_type::Wait;
+        case Op_exit:
+            return system_call_type::Exit;
+        case Op_fork_and_exec:
+            return system_call_type::Fork_and_exec;
+        case Op_memory_allocate:
+            return system_call_type::Memory_allocate;
+        case Op_memory_release:
+            return system_call_type::Memory_release;
+        default:
+            break;
     }
 
     fprintf(stderr, "Argument does not match system call command\n");
@@ -6,6 +6,9 @@
 #define HW3_SYSCALL_HPP
 
 #include <string>
+#include "Program.hpp"
+
+struct Simulator;
 
 enum system_call_type {
     Sleep,
@@ -18,61 +21,75 @@ enum system_call_type {
 
 /**
  * sleep function
+ * @param sim 실행 중인 시뮬레이터
  * @param p sleep할 프로세스
  * @param sleep_time sleep 시간
  */
-void sleep(int sleep_time);
+void sleep(Simulator &sim, int sleep_time);
 
 /**
  * fork_and_exec
- * @param p
- * @param program_name
+ * @param sim 실행 중인 시뮬레이터
+ * @param program_id 실행할 프로그램의 id (ProgramCache::intern)
  */
-void fork_and_exec(std::string program_name);
+void fork_and_exec(Simulator &sim, int program_id);
 
 /**
  * wait
+ * @param sim 실행 중인 시뮬레이터
  */
-void wait();
+void wait(Simulator &sim);
 
 /**
  * exit
+ * @param sim 실행 중인 시뮬레이터
  * @param p
  */
-void exit();
+void exit(Simulator &sim);
 
 /**
  * cycle 0 에서 실행되는 boot
+ * @param sim 실행 중인 시뮬레이터
  */
-void boot();
+void boot(Simulator &sim);
 
 /**
  * schedule function
+ * @param sim 실행 중인 시뮬레이터
  */
-void schedule();
+void schedule(Simulator &sim);
 
 /**
  * 시스템 콜이 아닐 떄, schedule 또는 idle 실행
+ * @param sim 실행 중인 시뮬레이터
  */
-void schedule_or_idle();
+void schedule_or_idle(Simulator &sim);
 
 /**
  * 메모리 할당 함수
+ * @param sim 실행 중인 시뮬레이터
  * @param allocation_size 할당할 메모리 크기 (페이지 개수)
  */
-void memory_allocate(int allocation_size);
+void memory_allocate(Simulator &sim, int allocation_size);
 
 /**
  * 메모리 해제 함수
+ * @param sim 실행 중인 시뮬레이터
  * @param allocation_id 해제할 메모리 allocation id
  */
-void memory_release(int allocation_id);
+void memory_release(Simulator &sim, int allocation_id);
 
 /**
  * status의 system_call_command 를 보고 시스템 콜을 처리
+ * @param sim 실행 중인 시뮬레이터
  */
-void system_call();
+void system_call(Simulator &sim);
 
-system_call_type string_to_system_call_type(const std::string& str);
+/**
+ * 디코딩된 명령어를 시스템 콜 종류로 변환
+ * @param op 시스템 콜 명령어의 opcode
+ * @return 시스템 콜 종류
+ */
+system_call_type opcode_to_system_call_type(opcode op);
 
 #endif //HW3_SYSCALL_HPP
@@ -4,7 +4,6 @@
 
 #include "System.hpp"
 #include <cassert>
-#include <limits>
 #include <algorithm>
 
 page_replacement_policy str_to_policy(const std::string& policy_str) {
@@ -16,12 +15,35 @@ page_replacement_policy str_to_policy(const std::string& policy_str) {
         return LFU;
     } else if (policy_str == MFU_STRING) {
         return MFU;
+    } else if (policy_str == CLOCK_STRING) {
+        return CLOCK;
+    } else if (policy_str == SECOND_CHANCE_STRING) {
+        return SECOND_CHANCE;
+    } else if (policy_str == CLOCK_PRO_STRING) {
+        return CLOCK_PRO;
+    } else if (policy_str == ARC_STRING) {
+        return ARC;
+    } else if (policy_str == TWO_Q_STRING) {
+        return TWO_Q;
+    } else if (policy_str == OPT_STRING) {
+        return OPT;
     }
 
     fprintf(stderr, "Not valid policy\n");
     throw;
 }
 
+victim_search str_to_victim_search(const std::string& search_str) {
+    if (search_str == INDEXED_VICTIM_SEARCH_STRING) {
+        return Indexed_victim_search;
+    } else if (search_str == SCAN_VICTIM_SEARCH_STRING) {
+        return Scan_victim_search;
+    }
+
+    fprintf(stderr, "Not valid victim search\n");
+    throw;
+}
+
 PhysicalFrame::PhysicalFrame(int process_id, int page_id, int fi_score, int fu_score, int ru_score) {
     this->process_id = process_id;
     this->page_id = page_id;
@@ -32,7 +54,8 @@ PhysicalFrame::PhysicalFrame(int process_id, int page_id, int fi_score, int fu_s
     linked_page = nullptr;
 }
 
-Process::Process(std::string name, int pid, int ppid, process_state state, int next_allocation_id, int next_page_id) {
+Process::Process(std::string name, int pid, int ppid, const MemoryGeometry& geometry, process_state state,
+                 int next_allocation_id, int next_page_id) {
 this->name = std::move(name);
 this->pid = pid;
 this->ppid = ppid;
@@ -40,8 +63,26 @@ this->state = state;
 this->next_allocation_id = next_allocation_id;
 this->next_page_id = next_page_id;
 // -1은 아무것도 할당되지 않음을 의미
-virtual_memory.assign(VIRTUAL_MEMORY_SIZE, -1);
-page_table.assign(VIRTUAL_MEMORY_SIZE, nullptr);
+#ifdef FIXED_GEOMETRY
+virtual_memory.fill(-1);
+page_table.fill(nullptr);
+#else
+virtual_memory.assign(geometry.virtual_memory_size, -1);
+page_table.assign(geometry.virtual_memory_size, nullptr);
+#endif
+}
+
+void Process::map_page(int virtual_address, int page_id) {
+    this->virtual_memory[virtual_address] = page_id;
+    this->page_address.emplace(page_id, virtual_address);
+}
+
+void Process::unmap_page(int virtual_address) {
+    auto it = this->page_address.find(this->virtual_memory[virtual_address]);
+    if (it != this->page_address.end() && it->second == virtual_address) {
+        this->page_address.erase(it);
+    }
+    this->virtual_memory[virtual_address] = -1;
 }
 
 PageTableEntry::PageTableEntry(int physical_address, int allocation_id, char authority) {
@@ -50,15 +91,31 @@ PageTableEntry::PageTableEntry(int physical_address, int allocation_id, char aut
     this->authority = authority;
 }
 
+std::vector<Process*>& PageSharers::at(const PageTableEntry* pe) {
+    size_t index = ObjectPool<PageTableEntry>::index_of(pe);
+    if (index >= this->sharers.size()) this->sharers.resize(index + 1);
+    return this->sharers[index];
+}
 
-int Status::free_memory_size() const {
-    int remaining_physical_memory_size = 0;
+void PageSharers::unshare(const PageTableEntry* pe, Process* p) {
+    std::vector<Process*>& pe_sharers = at(pe);
+    auto sharer = std::find(pe_sharers.begin(), pe_sharers.end(), p);
+    if (sharer == pe_sharers.end()) return;
+    *sharer = pe_sharers.back();
+    pe_sharers.pop_back();
+}
 
-    for (const auto& m: this->physical_memory) {
-        if (m == nullptr) remaining_physical_memory_size++;
-    }
+void Status::configure(const MemoryGeometry& memory_geometry) {
+    this->geometry = memory_geometry;
+    this->physical_memory = FrameTable(this->geometry.physical_memory_size);
+    this->free_frames = FrameAllocator(this->geometry.physical_memory_size);
+    this->replacer = make_replacer(this->replacement_policy, this->geometry.physical_memory_size,
+                                   this->future_references);
+    this->swap_space.reserve(this->geometry.swap_space_size);
+}
 
-    return remaining_physical_memory_size;
+int Status::free_memory_size() const {
+    return this->free_frames.free_size();
 }
 
 std::vector<int> Status::free_memory_addresses(int num) const {
@@ -68,127 +125,191 @@ std::vector<int> Status::free_memory_addresses(int num) const {
     }
 
     std::vector<int> addresses;
-    addresses.reserve(PHYSICAL_MEMORY_SIZE);
-
-    for (int i = 0; i < PHYSICAL_MEMORY_SIZE; i++) {
-        if (this->physical_memory[i] == nullptr) {
-            addresses.push_back(i);
-        }
-        if (addresses.size() == num) break;
-    }
+    addresses.reserve(num);
+    this->free_frames.lowest_free(num, addresses);
 
-    assert(addresses.size() == num);
+    assert(static_cast<int>(addresses.size()) == num);
     return addresses;
 }
 
+int Status::first_free_memory_address() const {
+    return this->free_frames.first_free();
+}
+
 void Status::replace_page() {
-    int min_score = std::numeric_limits<int>::max();
-    int max_score = -1;
-    int iteration = 0;
+    ScopedTimer timer(this->stats.timer(this->stats.replace_page_timer));
 
     // 교체 되어야 할 물리 메모리 인덱스
     int replace_index = -1;
 
-    switch (this->replacement_policy) {
+    if (this->victim_search_mode == Indexed_victim_search) {
+        replace_index = this->replacer->victim(this->physical_memory);
+    } else switch (this->replacement_policy) {
         case FIFO:
-            for (auto& m : this->physical_memory) {
-                if (m == nullptr) {iteration++; continue;}
-                if (m->fi_score < min_score) {
-                    min_score = m->fi_score;
-                    replace_index = iteration;
-                }
-                iteration++;
-            }
+            replace_index = this->physical_memory.min_score_address(this->physical_memory.fi_score);
             break;
         case LRU:
-            for (auto& m : this->physical_memory) {
-                if (m == nullptr) {iteration++; continue;}
-                if (m->ru_score < min_score) {
-                    min_score = m->ru_score;
-                    replace_index = iteration;
-                }
-                iteration++;
-            }
+            replace_index = this->physical_memory.min_score_address(this->physical_memory.ru_score);
             break;
         case LFU:
-            for (auto& m : this->physical_memory) {
-                if (m == nullptr) {iteration++; continue;}
-                if (m->fu_score < min_score) {
-                    min_score = m->fu_score;
-                    replace_index = iteration;
-                }
-                iteration++;
-            }
+            replace_index = this->physical_memory.min_score_address(this->physical_memory.fu_score);
             break;
         case MFU:
-            for (auto& m : this->physical_memory) {
-                if (m == nullptr) {iteration++; continue;}
-                if (m->fu_score > max_score) {
-                    max_score = m->fu_score;
-                    replace_index = iteration;
-                }
-                iteration++;
-            }
+            replace_index = this->physical_memory.max_score_address(this->physical_memory.fu_score);
+            break;
+        case CLOCK:
+        case SECOND_CHANCE:
+        case CLOCK_PRO:
+        case ARC:
+        case TWO_Q:
+        case OPT:
+            // hand 위치, 참조 비트, 교체 기록, 다음 참조 위치가 상태이므로 점수 선형 탐색 없이 항상 Replacer 사용
+            replace_index = this->replacer->victim(this->physical_memory);
             break;
     }
 
     assert(replace_index != -1);
 
     // Paging out
-    physical_memory[replace_index]->fu_score = 0;
-    physical_memory[replace_index]->fi_score = 0;
-    physical_memory[replace_index]->ru_score = 0;
-    this->swap_space.push_back(physical_memory[replace_index]);
-    this->physical_memory[replace_index] = nullptr;
+    this->stats.evictions++;
+    this->stats.swap_outs++;
+    PhysicalFrame* frame = this->take_frame(replace_index);
+    frame->fu_score = 0;
+    frame->fi_score = 0;
+    frame->ru_score = 0;
+    this->swap_space.push_back(frame);
 
     // 연결된 페이지 테이블 갱신
-    this->swap_space.back()->linked_page->physical_address = -1;
+    frame->linked_page->physical_address = -1;
 }
 
-std::vector<Process *> Status::get_child_processes(int parent_id) const {
-    auto res = std::vector<Process*>();
+void Status::place_frame(int address, const PhysicalFrame& frame) {
+    this->physical_memory.store(address, frame);
+    this->free_frames.occupy(address);
+    this->replacer->inserted(address, this->physical_memory);
+}
 
-    for (const auto pr: this->process_ready) {
-        if (pr == nullptr) continue;
-        if (pr->ppid == parent_id) res.push_back(pr);
-    }
+void Status::access_frame(int address) {
+    this->physical_memory.ru_score[address] = this->top_ru_score++;
+    this->physical_memory.fu_score[address]++;
+    this->physical_memory.referenced[address] = 1;
+    this->stats.memory_hits++;
+    this->replacer->accessed(address);
+}
+
+PhysicalFrame* Status::take_frame(int address) {
+    if (!this->physical_memory.is_occupied(address)) return nullptr;
+    PhysicalFrame* frame = this->frame_pool.create(this->physical_memory.load(address));
+    this->release_frame(address);
+    return frame;
+}
+
+void Status::release_frame(int address) {
+    if (!this->physical_memory.is_occupied(address)) return;
+    this->physical_memory.clear(address);
+    this->free_frames.release(address);
+    this->replacer->removed(address);
+}
 
-    for (const auto pw: this->process_waiting) {
-        if (pw == nullptr) continue;
-        if (pw->ppid == parent_id) res.push_back(pw);
+void WaitingList::push_back(Process* p) {
+    p->waiting_prev = tail;
+    p->waiting_next = nullptr;
+    if (tail == nullptr) {
+        head = p;
+    } else {
+        tail->waiting_next = p;
     }
+    tail = p;
+    count++;
+}
 
-    if (this->process_new != nullptr) {
-        if (this->process_new->ppid == parent_id) res.push_back(this->process_new);
+void WaitingList::remove(Process* p) {
+    if (p->waiting_prev == nullptr) {
+        head = p->waiting_next;
+    } else {
+        p->waiting_prev->waiting_next = p->waiting_next;
     }
-    if (this->process_running != nullptr) {
-        if (this->process_running->ppid == parent_id) res.push_back(this->process_running);
+    if (p->waiting_next == nullptr) {
+        tail = p->waiting_prev;
+    } else {
+        p->waiting_next->waiting_prev = p->waiting_prev;
     }
+    p->waiting_prev = nullptr;
+    p->waiting_next = nullptr;
+    count--;
+}
 
-    return res;
+void ProcessTable::add(Process* p) {
+    if (p->pid >= (int) processes.size()) processes.resize(p->pid + 1, nullptr);
+    processes[p->pid] = p;
+    count++;
+
+    Process* parent = find(p->ppid);
+    p->parent = parent;
+    p->prev_sibling = nullptr;
+    p->next_sibling = nullptr;
+    if (parent == nullptr) return;
+    p->prev_sibling = parent->last_child;
+    if (parent->last_child == nullptr) {
+        parent->first_child = p;
+    } else {
+        parent->last_child->next_sibling = p;
+    }
+    parent->last_child = p;
 }
 
-Process *Status::get_process_by_pid(int pid) const {
-    Process* p = nullptr;
+void ProcessTable::remove(Process* p) {
+    processes[p->pid] = nullptr;
+    count--;
 
-    for (const auto pr: this->process_ready) {
-        if (pr == nullptr) continue;
-        if (pr->pid == pid) return pr;
+    Process* parent = p->parent;
+    if (parent != nullptr) {
+        if (p->prev_sibling == nullptr) {
+            parent->first_child = p->next_sibling;
+        } else {
+            p->prev_sibling->next_sibling = p->next_sibling;
+        }
+        if (p->next_sibling == nullptr) {
+            parent->last_child = p->prev_sibling;
+        } else {
+            p->next_sibling->prev_sibling = p->prev_sibling;
+        }
     }
-
-    for (const auto pw: this->process_waiting) {
-        if (pw == nullptr) continue;
-        if (pw->pid == pid) return pw;
+    p->parent = nullptr;
+    p->prev_sibling = nullptr;
+    p->next_sibling = nullptr;
+
+    // 남은 자식은 부모 없이 계속 실행됨
+    Process* child = p->first_child;
+    while (child != nullptr) {
+        Process* next = child->next_sibling;
+        child->parent = nullptr;
+        child->prev_sibling = nullptr;
+        child->next_sibling = nullptr;
+        child = next;
     }
+    p->first_child = nullptr;
+    p->last_child = nullptr;
+}
 
-    if (this->process_new != nullptr) {
-        if (this->process_new->pid == pid) return this->process_new;
-    }
-    if (this->process_running != nullptr) {
-        if (this->process_running->pid == pid) return this->process_running;
+std::vector<Process *> Status::get_child_processes(int parent_id) const {
+    auto res = std::vector<Process*>();
+    Process* parent = this->processes.find(parent_id);
+    if (parent == nullptr) return res;
+
+    for (const auto child: this->processes.children(parent)) {
+        res.push_back(child);
     }
+    return res;
+}
 
-    return p;
+void Status::destroy_page_entry(PageTableEntry* pe) {
+    this->page_sharers.release(pe);
+    this->page_pool.destroy(pe);
+}
+
+Process *Status::get_process_by_pid(int pid) const {
+    return this->processes.find(pid);
 }
 
 
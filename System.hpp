@@ -7,8 +7,21 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <array>
+#include <deque>
+#include <type_traits>
 #include "Syscall.hpp"
 #include "Fault.hpp"
+#include "Replacement.hpp"
+#include "Swap.hpp"
+#include "FrameAllocator.hpp"
+#include "FrameTable.hpp"
+#include "Pool.hpp"
+#include "TimerWheel.hpp"
+#include "Stats.hpp"
+
+struct ProgramImage;
 
 // kString
 const std::string KERNEL_MODE_STRING = "kernel";
@@ -28,15 +41,70 @@ const std::string SCHEDULE_COMMAND_STRING = "schedule";
 const std::string IDLE_COMMAND_STRING = "idle";
 const std::string SYSTEM_CALL_COMMAND_STRING = "system call";
 const std::string FAULT_COMMAND_STRING = "fault";
+// 시스템 콜, 폴트 처리 직후 출력하는 빈 명령어
+const std::string EMPTY_COMMAND_STRING;
 
 const std::string LRU_STRING = "lru";
 const std::string FIFO_STRING = "fifo";
 const std::string MFU_STRING = "mfu";
 const std::string LFU_STRING = "lfu";
+const std::string CLOCK_STRING = "clock";
+const std::string SECOND_CHANCE_STRING = "second-chance";
+const std::string CLOCK_PRO_STRING = "clock-pro";
+const std::string ARC_STRING = "arc";
+const std::string TWO_Q_STRING = "2q";
+const std::string OPT_STRING = "opt";
+
+const std::string INDEXED_VICTIM_SEARCH_STRING = "indexed";
+const std::string SCAN_VICTIM_SEARCH_STRING = "scan";
 
+// 메모리 구성 기본값
 const int VIRTUAL_MEMORY_SIZE = 32;
 const int PHYSICAL_MEMORY_SIZE = 16;
 const int SWAP_SPACE_SIZE = 100;
+const int PRINT_FRAME_UNIT = 4;
+
+/**
+ * 메모리 구성 (가상 메모리, 물리 메모리, 스왑 영역 크기 및 출력할 때 한 묶음의 프레임 수)\n
+ * FIXED_GEOMETRY로 빌드하면 (make fixed) 기본값으로 고정된 상수가 되어
+ * 크기에 대한 반복문과 프로세스의 가상 메모리가 컴파일 타임 크기로 특수화된다.
+ */
+struct MemoryGeometry {
+#ifdef FIXED_GEOMETRY
+    static constexpr int virtual_memory_size = VIRTUAL_MEMORY_SIZE;
+    static constexpr int physical_memory_size = PHYSICAL_MEMORY_SIZE;
+    static constexpr int swap_space_size = SWAP_SPACE_SIZE;
+    static constexpr int print_frame_unit = PRINT_FRAME_UNIT;
+#else
+    int virtual_memory_size = VIRTUAL_MEMORY_SIZE;
+    int physical_memory_size = PHYSICAL_MEMORY_SIZE;
+    int swap_space_size = SWAP_SPACE_SIZE;
+    int print_frame_unit = PRINT_FRAME_UNIT;
+#endif
+};
+
+// 프로세스의 가상 메모리 크기만큼의 배열 (FIXED_GEOMETRY면 고정 크기 배열)
+#ifdef FIXED_GEOMETRY
+template<typename T>
+using PageArray = std::array<T, VIRTUAL_MEMORY_SIZE>;
+#else
+template<typename T>
+using PageArray = std::vector<T>;
+#endif
+
+/**
+ * 커널 모드 cycle에서 한 작업 (perform_cycle이 다음 커널 모드 cycle을 이것으로 분기)\n
+ * System_call_task, Fault_task는 처리할 시스템 콜, 폴트가 남은 상태이고, 나머지는 다음 커널 모드 cycle에 스케쥴한다.
+ * 출력용 문자열은 status.command
+ */
+enum kernel_task {
+    No_kernel_task, // 시스템 콜, 폴트 처리 직후
+    Boot_task,
+    Schedule_task,
+    Idle_task,
+    System_call_task,
+    Fault_task,
+};
 
 enum process_state {
     New,
@@ -46,15 +114,12 @@ enum process_state {
     Terminated,
 };
 
-enum page_replacement_policy {
-    FIFO,
-    LRU,
-    MFU,
-    LFU,
-};
-
 page_replacement_policy str_to_policy(const std::string& policy_str);
 
+victim_search str_to_victim_search(const std::string& search_str);
+
+struct Process;
+
 struct PageTableEntry {
     int physical_address;
     int allocation_id;
@@ -63,6 +128,57 @@ struct PageTableEntry {
     PageTableEntry(int physical_address, int allocation_id, char authority = 'W');
 };
 
+// page_pool의 reset이 엔트리마다 소멸자를 부르지 않도록 유지
+static_assert(std::is_trivially_destructible<PageTableEntry>::value, "PageTableEntry must stay trivially destructible");
+
+/**
+ * 페이지 테이블 엔트리마다 그 엔트리를 페이지 테이블에 가지고 있는 프로세스 목록\n
+ * fork로 공유되면 여럿이고 CoW 복사 시 빠진다. 엔트리의 page_pool slot 번호로 인덱싱하며,
+ * PageTableEntry를 소멸자 없는 타입으로 두어 page_pool의 reset이 O(1)이도록 엔트리 밖에 둔다.
+ */
+class PageSharers {
+private:
+    std::vector<std::vector<Process*>> sharers; // slot 번호 -> 공유하는 프로세스
+
+    std::vector<Process*>& at(const PageTableEntry* pe);
+
+public:
+    /**
+     * 엔트리를 공유하는 프로세스 추가
+     * @param pe 페이지 테이블 엔트리
+     * @param p 페이지 테이블에 이 엔트리를 넣은 프로세스
+     */
+    void share(const PageTableEntry* pe, Process* p) {
+        at(pe).push_back(p);
+    }
+
+    /**
+     * 엔트리를 공유하는 프로세스에서 제외 (없으면 무시)
+     * @param pe 페이지 테이블 엔트리
+     * @param p 페이지 테이블에서 이 엔트리를 뺀 프로세스
+     */
+    void unshare(const PageTableEntry* pe, Process* p);
+
+    /**
+     * 엔트리를 공유하는 프로세스 (share 순서, unshare 시 마지막 프로세스가 빠진 자리로 옮겨짐)
+     */
+    const std::vector<Process*>& of(const PageTableEntry* pe) {
+        return at(pe);
+    }
+
+    size_t count(const PageTableEntry* pe) {
+        return at(pe).size();
+    }
+
+    /**
+     * 엔트리가 해제될 때 목록 비움 (slot이 다시 쓰일 때 빈 목록으로 시작)
+     * @param pe 해제할 페이지 테이블 엔트리
+     */
+    void release(const PageTableEntry* pe) {
+        at(pe).clear();
+    }
+};
+
 struct PhysicalFrame {
     int process_id;
     int page_id;
@@ -96,40 +212,211 @@ struct Process {
     int ppid; // 부모 프로세스 ID
     char waiting_type = '\0'; // waiting일 때 S, W중 하나
     process_state state; // process_state
-    int remain_sleep_time = 0; // 남은 sleep time
+    Process* waiting_prev = nullptr; // waiting queue (WaitingList) 연결
+    Process* waiting_next = nullptr;
+    // 프로세스 테이블 (ProcessTable)의 부모-자식 연결, 종료되지 않은 자식만 연결됨
+    Process* parent = nullptr;
+    Process* first_child = nullptr;
+    Process* last_child = nullptr;
+    Process* prev_sibling = nullptr;
+    Process* next_sibling = nullptr;
     int current_line = 1; // 현재 읽고 있는 명령어 줄
-    std::vector<int> virtual_memory;
-    std::vector<PageTableEntry*> page_table;
+    const ProgramImage* image = nullptr; // 실행 중인 프로그램 이미지 (ProgramCache 소유)
+    PageArray<int> virtual_memory; // 직접 쓰지 말고 map_page, unmap_page 사용
+    PageArray<PageTableEntry*> page_table;
+    std::unordered_map<int, int> page_address; // page id -> 가상 메모리 주소
+    // allocation id -> 그 할당의 페이지가 있는 가상 메모리 주소 (오름차순, fork로 물려받은 할당 포함)
+    std::unordered_map<int, std::vector<int>> allocation_addresses;
     int next_allocation_id;
     int next_page_id;
+    int syscall_cycle = -1; // 처리 중인 시스템 콜을 호출한 cycle (통계용), 없으면 -1
+    system_call_type pending_syscall = Sleep; // 처리 중인 시스템 콜 종류 (통계용)
 
     /**
      * 생성자
      * @param name 프로그램 이름
      * @param pid  프로세스 id
      * @param ppid 부모 프로세스 id
+     * @param geometry 메모리 구성 (가상 메모리 크기)
      * @param state 프로세스 상태
      * @param next_allocation_id 프로세스의 다음 메모리 할당 id
      */
-    Process(std::string name, int pid, int ppid, process_state state = New, int next_allocation_id = 0,
-            int last_page_id = 0);
+    Process(std::string name, int pid, int ppid, const MemoryGeometry& geometry, process_state state = New,
+            int next_allocation_id = 0, int last_page_id = 0);
+
+    /**
+     * 가상 메모리에 페이지 배치
+     * @param virtual_address 가상 메모리 주소
+     * @param page_id 배치할 page id
+     */
+    void map_page(int virtual_address, int page_id);
+
+    /**
+     * 가상 메모리에서 페이지 제거
+     * @param virtual_address 가상 메모리 주소
+     */
+    void unmap_page(int virtual_address);
+
+    /**
+     * page id가 배치된 가상 메모리 주소
+     * @param page_id 찾을 page id
+     * @return 가상 메모리 주소, 없으면 -1
+     */
+    int virtual_address_of(int page_id) const {
+        auto it = page_address.find(page_id);
+        return it == page_address.end() ? -1 : it->second;
+    }
+};
+
+/**
+ * waiting 상태 프로세스의 intrusive 이중 연결 리스트\n
+ * 들어온 순서를 유지하며 삽입, 삭제가 O(1)이다. (연결 포인터는 Process에 있음)
+ */
+class WaitingList {
+private:
+    Process* head = nullptr;
+    Process* tail = nullptr;
+    size_t count = 0;
+
+public:
+    class iterator {
+    private:
+        Process* current;
+
+    public:
+        explicit iterator(Process* current) : current(current) {}
+
+        Process* operator*() const { return current; }
+
+        iterator& operator++() {
+            current = current->waiting_next;
+            return *this;
+        }
+
+        bool operator!=(const iterator& other) const { return current != other.current; }
+    };
+
+    void push_back(Process* p);
+
+    void remove(Process* p);
+
+    bool empty() const { return count == 0; }
+
+    size_t size() const { return count; }
+
+    iterator begin() const { return iterator(head); }
+
+    iterator end() const { return iterator(nullptr); }
+};
+
+/**
+ * 종료되지 않은 프로세스 테이블
+ *
+ * pid는 1부터 차례로 붙으므로 pid로 인덱싱하는 vector에 두어 조회가 O(1)이고,
+ * 자식 목록은 Process의 intrusive 연결(parent, first_child, next_sibling, ...)로 fork 순서대로 유지한다.
+ */
+class ProcessTable {
+private:
+    std::vector<Process*> processes; // pid -> 프로세스, 없으면 nullptr
+    size_t count = 0;
+
+public:
+    class child_iterator {
+    private:
+        Process* current;
+
+    public:
+        explicit child_iterator(Process* current) : current(current) {}
+
+        Process* operator*() const { return current; }
+
+        child_iterator& operator++() {
+            current = current->next_sibling;
+            return *this;
+        }
+
+        bool operator!=(const child_iterator& other) const { return current != other.current; }
+    };
+
+    struct ChildRange {
+        Process* first;
+
+        child_iterator begin() const { return child_iterator(first); }
+
+        child_iterator end() const { return child_iterator(nullptr); }
+    };
+
+    /**
+     * 프로세스 등록 (부모 ppid가 테이블에 있으면 부모의 자식 목록 끝에 연결)
+     * @param p 등록할 프로세스 (pid가 테이블에 없어야 함)
+     */
+    void add(Process* p);
+
+    /**
+     * 프로세스 등록 해제 (부모의 자식 목록에서 빠지고, 남은 자식들은 부모 연결이 끊김)
+     * @param p 등록된 프로세스
+     */
+    void remove(Process* p);
+
+    /**
+     * @param pid 찾을 프로세스 id
+     * @return 프로세스, 없으면 nullptr
+     */
+    Process* find(int pid) const {
+        if (pid < 0 || pid >= (int) processes.size()) return nullptr;
+        return processes[pid];
+    }
+
+    /**
+     * 종료되지 않은 자식 프로세스 (fork 순서)
+     */
+    ChildRange children(const Process* parent) const { return ChildRange{parent->first_child}; }
+
+    bool empty() const { return count == 0; }
+
+    size_t size() const { return count; }
 };
 
 struct Status {
+    // 시뮬레이션 동안 만든 프레임, 페이지 테이블 엔트리, 프로세스를 소유 (Status와 함께 정리됨)
+    ObjectPool<PhysicalFrame> frame_pool;
+    ObjectPool<PageTableEntry> page_pool;
+    ObjectPool<Process> process_pool;
+    // page_pool 엔트리를 공유하는 프로세스
+    PageSharers page_sharers;
+
     int cycle;
     std::string mode;
-    std::string command;
+    // 출력용 명령어 (프로그램 이미지의 줄 또는 *_COMMAND_STRING)
+    const std::string* command = &EMPTY_COMMAND_STRING;
+    kernel_task task = No_kernel_task;
     Process* process_running;
-    std::vector<Process*> process_ready; // ready queue
-    std::vector<Process*> process_waiting;
+    std::deque<Process*> process_ready; // ready queue
+    WaitingList process_waiting; // waiting queue (들어온 순서 유지)
+    // sleep 중인 프로세스 (깨어날 tick에 만료되는 타이머)
+    TimerWheel<Process*> process_sleeping;
+    // 자식의 exit를 기다리는(wait) 프로세스 (pid -> 프로세스)
+    std::unordered_map<int, Process*> process_waiting_for_child;
+    // 종료되지 않은 프로세스 (boot, fork_and_exec에서 등록, exit에서 해제)
+    ProcessTable processes;
+    int tick = 0; // update() 호출 횟수 (sleep 시간 단위)
     Process* process_new;
     Process* process_terminated;
     system_call_type syscall_type;
     fault_type fault_handler_type;
-    std::string syscall_arg;
-    std::vector<PhysicalFrame*> physical_memory = std::vector<PhysicalFrame*>(PHYSICAL_MEMORY_SIZE, nullptr);
-    std::vector<PhysicalFrame*> swap_space = std::vector<PhysicalFrame*>();
+    int syscall_arg; // 시스템 콜 인자 또는 폴트가 발생한 page id
+    MemoryGeometry geometry;
+    // 물리 메모리에 있는 프레임 (swap에 있는 프레임만 PhysicalFrame 객체로 존재)
+    FrameTable physical_memory = FrameTable(PHYSICAL_MEMORY_SIZE);
+    // physical_memory의 빈 프레임 비트맵
+    FrameAllocator free_frames = FrameAllocator(PHYSICAL_MEMORY_SIZE);
+    SwapSpace swap_space;
     page_replacement_policy replacement_policy;
+    victim_search victim_search_mode = Indexed_victim_search;
+    // 교체 대상 선택용 자료구조 (Indexed_victim_search 일 때 사용)
+    std::unique_ptr<Replacer> replacer;
+    // OPT 사전 실행의 참조 스트림 색인 (OPT일 때만 사용)
+    std::shared_ptr<ReferenceIndex> future_references;
 
     int process_num = 0;
 
@@ -137,6 +424,16 @@ struct Status {
     int top_fi_score = 0;
     int top_fu_score = 0;
 
+    // 실행 통계
+    Statistics stats;
+
+    /**
+     * 메모리 구성 설정 후 물리 메모리, 빈 프레임 비트맵, 교체 자료구조, 스왑 영역을 그 크기로 초기화\n
+     * replacement_policy, victim_search_mode (OPT는 future_references도) 가 먼저 설정되어 있어야 함
+     * @param memory_geometry 메모리 구성
+     */
+    void configure(const MemoryGeometry& memory_geometry);
+
     /**
      * 남은 물리 메모리 공간을 프레임 단위로 반환
      * @return 물리 메모리에 남은 프레임 수
@@ -151,13 +448,60 @@ struct Status {
     std::vector<int> free_memory_addresses(int num) const;
 
     /**
-     * 페이지 교체
-     * @param num_of_replace 교체되어야 할 페이지 수
+     * 가장 낮은 빈 메모리 주소(인덱스)
+     * @return 메모리 주소, 남은 공간이 없으면 -1
+     */
+    int first_free_memory_address() const;
+
+    /**
+     * 페이지 교체 (교체 대상 프레임을 스왑 영역으로 내보냄)
      */
     void replace_page();
 
+    /**
+     * 물리 메모리에 프레임 배치 (점수는 호출 전에 갱신되어 있어야 함)\n
+     * 프레임의 값이 프레임 테이블로 복사되므로 frame_pool에서 꺼낸 객체는 호출한 쪽에서 반환해야 함
+     * @param address 물리 메모리 주소
+     * @param frame 배치할 프레임
+     */
+    void place_frame(int address, const PhysicalFrame& frame);
+
+    /**
+     * memory_read/memory_write로 프레임 접근 시 ru, fu 점수 갱신
+     * @param address 물리 메모리 주소
+     */
+    void access_frame(int address);
+
+    /**
+     * 물리 메모리에서 프레임을 빼냄 (스왑 영역으로 내보낼 때)
+     * @param address 물리 메모리 주소
+     * @return 빠진 프레임 (frame_pool 소유), 빈 프레임이면 nullptr
+     */
+    PhysicalFrame* take_frame(int address);
+
+    /**
+     * 물리 메모리에서 프레임 해제 (빈 프레임이면 무시)
+     * @param address 물리 메모리 주소
+     */
+    void release_frame(int address);
+
+    /**
+     * 페이지 테이블 엔트리 해제 (공유 목록도 비움)
+     * @param pe page_pool에서 만든 엔트리
+     */
+    void destroy_page_entry(PageTableEntry* pe);
+
+    /**
+     * 종료되지 않은 프로세스 조회 (프로세스 테이블, O(1))
+     * @param pid 프로세스 id
+     * @return 프로세스, 없으면 nullptr
+     */
     Process* get_process_by_pid(int pid) const;
 
+    /**
+     * 종료되지 않은 자식 프로세스 (fork 순서)
+     * @param parent_id 부모 프로세스 id
+     */
     std::vector<Process*> get_child_processes(int parent_id) const;
 };
 
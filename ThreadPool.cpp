@@ -0,0 +1,57 @@
+#include "ThreadPool.hpp"
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int worker_count) {
+    if (worker_count <= 0) {
+        worker_count = (int) std::thread::hardware_concurrency();
+        if (worker_count <= 0) worker_count = 1;
+    }
+    for (int i = 0; i < worker_count; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    queues[next_queue]->tasks.push_back(std::move(task));
+    next_queue = (next_queue + 1) % queues.size();
+}
+
+bool WorkStealingPool::pop(size_t worker, std::function<void()>& task) {
+    WorkQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t worker, std::function<void()>& task) {
+    for (size_t i = 1; i < queues.size(); i++) {
+        WorkQueue& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::work(size_t worker) {
+    std::function<void()> task;
+    while (pop(worker, task) || steal(worker, task)) {
+        task();
+    }
+}
+
+void WorkStealingPool::run() {
+    std::vector<std::thread> threads;
+    // 0번 워커는 호출한 스레드가 맡는다
+    for (size_t i = 1; i < queues.size(); i++) {
+        threads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+    work(0);
+    for (auto& thread: threads) {
+        thread.join();
+    }
+}
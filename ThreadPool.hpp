@@ -0,0 +1,58 @@
+#ifndef HW3_THREAD_POOL_HPP
+#define HW3_THREAD_POOL_HPP
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * 작업 훔치기(work stealing) 스레드 풀\n
+ * 작업은 워커별 큐에 번갈아 넣고, 워커는 자기 큐의 뒤에서 꺼내다가 비면 다른 워커 큐의 앞에서 훔쳐 온다.
+ * 실행 중에 작업이 추가되지 않으므로 모든 큐가 비면 워커가 종료된다.
+ */
+class WorkStealingPool {
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    size_t next_queue = 0;
+
+    /**
+     * 자기 큐의 뒤에서 작업을 꺼냄
+     */
+    bool pop(size_t worker, std::function<void()>& task);
+
+    /**
+     * 다른 워커 큐의 앞에서 작업을 훔쳐 옴
+     */
+    bool steal(size_t worker, std::function<void()>& task);
+
+    void work(size_t worker);
+
+public:
+    /**
+     * 생성자
+     * @param worker_count 워커 스레드 수 (0 이하이면 하드웨어 스레드 수)
+     */
+    explicit WorkStealingPool(int worker_count);
+
+    /**
+     * 작업 추가 (run 호출 전에)
+     * @param task 실행할 작업
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * 추가된 작업을 모두 실행하고 끝날 때까지 대기
+     */
+    void run();
+
+    size_t worker_count() const { return queues.size(); }
+};
+
+#endif //HW3_THREAD_POOL_HPP
@@ -0,0 +1,161 @@
+#ifndef HW3_TIMER_WHEEL_HPP
+#define HW3_TIMER_WHEEL_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * 계층형 타이밍 휠 (tick 단위 타이머)\n
+ * 레벨마다 64칸이 있고 레벨 L의 한 칸은 64^L tick을 덮는다. 타이머는 현재 tick과 만료 tick이
+ * 처음으로 달라지는 자릿수의 레벨에 들어가며, 그 레벨의 칸 경계에 도달하면 아래 레벨로 내려간다(cascade).
+ * 칸마다 비트맵을 두어 다음에 할 일이 있는 tick으로 바로 건너뛰므로, 만료되지 않는 타이머는 건드리지 않는다.
+ * 같은 tick에 만료되는 타이머는 등록된 순서대로 꺼낸다.
+ * @tparam T 타이머 값
+ */
+template<typename T>
+class TimerWheel {
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOT_COUNT = 1 << SLOT_BITS;
+    // 6레벨 = 36비트, int 범위의 tick을 모두 덮는다
+    static const int LEVEL_COUNT = 6;
+
+    struct Timer {
+        uint64_t deadline;
+        uint64_t sequence;
+        T value;
+    };
+
+    std::vector<Timer> slots[LEVEL_COUNT][SLOT_COUNT];
+    // 레벨마다 타이머가 있는 칸의 비트맵
+    uint64_t occupied[LEVEL_COUNT] = {};
+    std::vector<Timer> expired;
+    uint64_t now = 0;
+    uint64_t next_sequence = 0;
+    size_t count = 0;
+
+    static int digit(uint64_t tick, int level) {
+        return (int) ((tick >> (SLOT_BITS * level)) & (SLOT_COUNT - 1));
+    }
+
+    void insert(const Timer& timer) {
+        int level = 0;
+        while (level < LEVEL_COUNT - 1
+               && (timer.deadline >> (SLOT_BITS * (level + 1))) != (now >> (SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+        int index = digit(timer.deadline, level);
+        slots[level][index].push_back(timer);
+        occupied[level] |= uint64_t(1) << index;
+    }
+
+    /**
+     * 현재 tick 이후에 타이머가 있는 가장 이른 칸의 레벨과 번호\n
+     * 레벨 L의 타이머는 현재 tick과 같은 상위 블록 안에서 현재 자릿수보다 뒤의 칸에 있으므로
+     * 낮은 레벨의 타이머가 항상 먼저 만료된다.
+     * @return 타이머가 없으면 false
+     */
+    bool earliest_slot(int& level, int& index) const {
+        for (level = 0; level < LEVEL_COUNT; level++) {
+            if (occupied[level] == 0) continue;
+            index = __builtin_ctzll(occupied[level]);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * 현재 tick 이후 처음으로 처리할 일이 있는 tick (레벨 0 칸의 만료 또는 상위 레벨 칸의 cascade)
+     */
+    uint64_t next_event() const {
+        int level = 0, index = 0;
+        earliest_slot(level, index);
+        uint64_t block = now >> (SLOT_BITS * (level + 1)) << (SLOT_BITS * (level + 1));
+        return block + ((uint64_t) index << (SLOT_BITS * level));
+    }
+
+    /**
+     * 현재 tick을 tick으로 옮기고 그 tick에 할 일 처리 (tick까지 다른 일은 없어야 함)
+     */
+    template<typename Expire>
+    void step_to(uint64_t tick, Expire& expire) {
+        now = tick;
+        // 칸 경계에 도달한 상위 레벨의 타이머를 아래 레벨로 내림
+        for (int level = 1; level < LEVEL_COUNT; level++) {
+            if ((now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+            int index = digit(now, level);
+            if (slots[level][index].empty()) continue;
+            std::vector<Timer> cascading;
+            cascading.swap(slots[level][index]);
+            occupied[level] &= ~(uint64_t(1) << index);
+            for (const auto& timer: cascading) insert(timer);
+        }
+
+        int index = digit(now, 0);
+        auto& slot = slots[0][index];
+        if (slot.empty()) return;
+        expired.clear();
+        expired.swap(slot);
+        occupied[0] &= ~(uint64_t(1) << index);
+        // cascade로 내려온 타이머가 뒤에 붙을 수 있으므로 등록 순서로 정렬
+        std::sort(expired.begin(), expired.end(),
+                  [](const Timer& a, const Timer& b) { return a.sequence < b.sequence; });
+        count -= expired.size();
+        for (const auto& timer: expired) expire(timer.value);
+    }
+
+public:
+    /**
+     * 타이머 등록
+     * @param deadline 만료 tick (현재 tick보다 커야 함)
+     * @param value 만료될 때 돌려줄 값
+     */
+    void schedule(uint64_t deadline, T value) {
+        insert(Timer{deadline, next_sequence++, value});
+        count++;
+    }
+
+    /**
+     * tick까지 진행하며 만료된 타이머의 값을 (만료 tick, 등록 순서) 순으로 expire에 넘김\n
+     * 할 일이 있는 tick으로만 건너뛰므로 비용은 진행한 tick 수가 아니라 만료와 cascade 횟수에 비례한다.
+     * @param tick 진행할 tick
+     * @param expire 만료된 값을 받는 함수
+     */
+    template<typename Expire>
+    void advance(uint64_t tick, Expire&& expire) {
+        while (now < tick) {
+            if (count == 0) {
+                now = tick;
+                break;
+            }
+            uint64_t next = next_event();
+            if (next > tick) {
+                now = tick;
+                break;
+            }
+            step_to(next, expire);
+        }
+    }
+
+    /**
+     * 가장 먼저 만료될 타이머의 tick
+     * @return 만료 tick, 타이머가 없으면 0
+     */
+    uint64_t next_deadline() const {
+        int level = 0, index = 0;
+        if (!earliest_slot(level, index)) return 0;
+        uint64_t deadline = UINT64_MAX;
+        for (const auto& timer: slots[level][index]) deadline = std::min(deadline, timer.deadline);
+        return deadline;
+    }
+
+    bool empty() const { return count == 0; }
+
+    size_t size() const { return count; }
+
+    uint64_t current_tick() const { return now; }
+};
+
+#endif //HW3_TIMER_WHEEL_HPP
@@ -0,0 +1,88 @@
+#include "Trace.hpp"
+#include <cstring>
+
+trace_mode str_to_trace_mode(const std::string& mode_str) {
+    if (mode_str == TEXT_TRACE_STRING) {
+        return Text_trace;
+    } else if (mode_str == BINARY_TRACE_STRING) {
+        return Binary_trace;
+    } else if (mode_str == NO_TRACE_STRING) {
+        return No_trace;
+    }
+
+    fprintf(stderr, "Not valid trace mode\n");
+    throw;
+}
+
+void TraceWriter::open(FILE* output_file) {
+    this->file = output_file;
+    this->used = 0;
+    if (this->buffer == nullptr) {
+        this->buffer = std::make_unique<char[]>(BUFFER_SIZE);
+    }
+    // 직접 버퍼링 하므로 stdio 버퍼는 사용하지 않음
+    setvbuf(this->file, nullptr, _IONBF, 0);
+}
+
+void TraceWriter::close() {
+    this->flush();
+    fclose(this->file);
+    this->file = nullptr;
+}
+
+void TraceWriter::flush() {
+    if (this->used > 0) {
+        fwrite(this->buffer.get(), 1, this->used, this->file);
+        this->used = 0;
+    }
+}
+
+void TraceWriter::write(const char* str, size_t length) {
+    if (this->used + length > BUFFER_SIZE) {
+        this->flush();
+        if (length > BUFFER_SIZE) {
+            fwrite(str, 1, length, this->file);
+            return;
+        }
+    }
+    memcpy(this->buffer.get() + this->used, str, length);
+    this->used += length;
+}
+
+void TraceWriter::write(const char* str) {
+    this->write(str, strlen(str));
+}
+
+void TraceWriter::write_int(int value) {
+    // int 최솟값까지 담을 수 있는 크기
+    char digits[12];
+    int length = 0;
+    // 음수도 처리할 수 있도록 unsigned로 변환
+    unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+
+    do {
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) digits[length++] = '-';
+
+    if (this->used + length > BUFFER_SIZE) this->flush();
+    char* out = this->buffer.get() + this->used;
+    for (int i = 0; i < length; i++) {
+        out[i] = digits[length - 1 - i];
+    }
+    this->used += length;
+}
+
+void TraceWriter::write_varint(uint64_t value) {
+    // 64비트 정수는 최대 10바이트
+    if (this->used + 10 > BUFFER_SIZE) this->flush();
+    char* out = this->buffer.get() + this->used;
+    int length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out[length++] = static_cast<char>(value);
+    this->used += length;
+}
@@ -0,0 +1,93 @@
+#ifndef HW3_TRACE_HPP
+#define HW3_TRACE_HPP
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+enum trace_mode {
+    Text_trace, // 기존 result 텍스트 형식
+    Binary_trace, // cycle별 변경분만 기록하는 바이너리 형식 (trace_decode로 텍스트 복원)
+    No_trace, // 출력하지 않음
+};
+
+const std::string TEXT_TRACE_STRING = "text";
+const std::string BINARY_TRACE_STRING = "binary";
+const std::string NO_TRACE_STRING = "none";
+
+// 바이너리 trace 파일 맨 앞의 식별자
+const char BINARY_TRACE_MAGIC[8] = {'P', '3', 'T', 'R', 'A', 'C', 'E', '1'};
+
+// 바이너리 trace cycle 레코드의 flag 비트
+const uint8_t TRACE_FLAG_USER_MODE = 1 << 0;
+const uint8_t TRACE_FLAG_RUNNING = 1 << 1;
+const uint8_t TRACE_FLAG_NEW_PROCESS = 1 << 2;
+
+trace_mode str_to_trace_mode(const std::string& mode_str);
+
+/**
+ * cycle별 상태 출력을 위한 버퍼 writer\n
+ * 출력을 내부 버퍼에 모아 두었다가 버퍼가 차면 한 번에 fwrite 한다.
+ */
+class TraceWriter {
+private:
+    static const size_t BUFFER_SIZE = 1 << 16;
+
+    FILE* file = nullptr;
+    std::unique_ptr<char[]> buffer;
+    size_t used = 0;
+
+public:
+    /**
+     * 출력 파일 지정, 파일 자체 버퍼링은 끈다
+     * @param output_file 출력 파일
+     */
+    void open(FILE* output_file);
+
+    /**
+     * 남은 버퍼를 쓰고 파일을 닫는다
+     */
+    void close();
+
+    /**
+     * 버퍼에 모인 내용을 파일에 쓴다
+     */
+    void flush();
+
+    void write(const char* str, size_t length);
+
+    void write(const std::string& str) {
+        write(str.data(), str.size());
+    }
+
+    void write(const char* str);
+
+    void write(char c) {
+        if (used == BUFFER_SIZE) flush();
+        buffer[used++] = c;
+    }
+
+    /**
+     * 10진수 정수 출력 (printf의 %d와 같은 형식)
+     * @param value 출력할 정수
+     */
+    void write_int(int value);
+
+    /**
+     * LEB128 가변 길이 정수 출력 (바이너리 trace 용)
+     * @param value 출력할 정수
+     */
+    void write_varint(uint64_t value);
+
+    /**
+     * zigzag 인코딩 후 가변 길이 정수 출력 (음수가 나올 수 있는 값)
+     * @param value 출력할 정수
+     */
+    void write_signed_varint(int64_t value) {
+        write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+};
+
+#endif //HW3_TRACE_HPP
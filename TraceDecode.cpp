@@ -0,0 +1,269 @@
+// 바이너리 trace (--trace=binary) 를 result 텍스트 형식으로 복원하는 도구
+// 사용법: trace_decode [--from=N] [--to=N] <binary trace> [output]
+
+#include "Trace.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+const std::string FROM_OPTION = "--from=";
+const std::string TO_OPTION = "--to=";
+
+/**
+ * 바이너리 trace 파일을 버퍼 단위로 읽는 reader
+ */
+class TraceReader {
+private:
+    static const size_t BUFFER_SIZE = 1 << 16;
+
+    FILE* file;
+    char buffer[BUFFER_SIZE];
+    size_t position = 0;
+    size_t length = 0;
+
+    bool fill() {
+        position = 0;
+        length = fread(buffer, 1, BUFFER_SIZE, file);
+        return length > 0;
+    }
+
+public:
+    explicit TraceReader(FILE* trace_file) : file(trace_file) {}
+
+    bool at_end() {
+        return position == length && !fill();
+    }
+
+    char read_byte() {
+        if (position == length && !fill()) {
+            fprintf(stderr, "Unexpected end of trace\n");
+            exit(1);
+        }
+        return buffer[position++];
+    }
+
+    void read(char* out, size_t size) {
+        for (size_t i = 0; i < size; i++) out[i] = read_byte();
+    }
+
+    uint64_t read_varint() {
+        uint64_t value = 0;
+        int shift = 0;
+        while (true) {
+            auto byte = static_cast<uint8_t>(read_byte());
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+            shift += 7;
+        }
+    }
+
+    int64_t read_signed_varint() {
+        uint64_t value = read_varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+};
+
+struct VirtualCell {
+    int page_id = -1;
+    char authority = 0;
+    int physical_address = -1;
+};
+
+struct DecodedProcess {
+    int ppid = 0;
+    int name_id = 0;
+    std::vector<VirtualCell> cells;
+};
+
+static std::vector<std::string> strings;
+
+static int read_string(TraceReader& reader) {
+    uint64_t reference = reader.read_varint();
+    if (reference != 0) return static_cast<int>(reference - 1);
+
+    std::string str(reader.read_varint(), '\0');
+    reader.read(&str[0], str.size());
+    strings.push_back(std::move(str));
+    return static_cast<int>(strings.size() - 1);
+}
+
+int main(int argc, char* argv[]) {
+    long from_cycle = 0;
+    long to_cycle = -1;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, FROM_OPTION.size(), FROM_OPTION) == 0) {
+            from_cycle = std::stol(arg.substr(FROM_OPTION.size()));
+        } else if (arg.compare(0, TO_OPTION.size(), TO_OPTION) == 0) {
+            to_cycle = std::stol(arg.substr(TO_OPTION.size()));
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.empty() || positional.size() > 2) {
+        fprintf(stderr, "usage: trace_decode [--from=N] [--to=N] <binary trace> [output]\n");
+        exit(1);
+    }
+
+    FILE* input = fopen(positional[0].c_str(), "rb");
+    if (input == nullptr) {
+        fprintf(stderr, "cannot open %s\n", positional[0].c_str());
+        exit(1);
+    }
+    FILE* output = positional.size() == 2 ? fopen(positional[1].c_str(), "w") : stdout;
+    if (output == nullptr) {
+        fprintf(stderr, "cannot open %s\n", positional[1].c_str());
+        exit(1);
+    }
+
+    TraceReader reader(input);
+    char magic[sizeof(BINARY_TRACE_MAGIC)];
+    reader.read(magic, sizeof(magic));
+    if (memcmp(magic, BINARY_TRACE_MAGIC, sizeof(magic)) != 0) {
+        fprintf(stderr, "not a binary trace\n");
+        exit(1);
+    }
+    const int virtual_memory_size = static_cast<int>(reader.read_varint());
+    const int physical_memory_size = static_cast<int>(reader.read_varint());
+    const int print_frame_unit = static_cast<int>(reader.read_varint());
+
+    auto separator = [print_frame_unit](int i) {
+        return i % print_frame_unit == print_frame_unit - 1 ? '|' : ' ';
+    };
+
+    // 복원 중인 상태
+    std::vector<std::pair<int, int>> physical_memory(physical_memory_size, {-1, -1});
+    std::unordered_map<int, DecodedProcess> processes;
+
+    TraceWriter out;
+    out.open(output);
+
+    long cycle = 0;
+    while (!reader.at_end()) {
+        cycle += static_cast<long>(reader.read_varint());
+        auto flag = static_cast<uint8_t>(reader.read_byte());
+        int command_id = read_string(reader);
+
+        DecodedProcess* running = nullptr;
+        int running_pid = 0;
+        if (flag & TRACE_FLAG_RUNNING) {
+            running_pid = static_cast<int>(reader.read_varint());
+            running = &processes[running_pid];
+            if (flag & TRACE_FLAG_NEW_PROCESS) {
+                running->ppid = static_cast<int>(reader.read_varint());
+                running->name_id = read_string(reader);
+                running->cells.assign(virtual_memory_size, VirtualCell());
+            }
+        }
+
+        uint64_t physical_changes = reader.read_varint();
+        for (uint64_t i = 0; i < physical_changes; i++) {
+            auto index = reader.read_varint();
+            int pid = static_cast<int>(reader.read_varint()) - 1;
+            int page_id = pid == -1 ? -1 : static_cast<int>(reader.read_varint());
+            physical_memory[index] = {pid, page_id};
+        }
+
+        if (running != nullptr) {
+            uint64_t virtual_changes = reader.read_varint();
+            for (uint64_t i = 0; i < virtual_changes; i++) {
+                auto& cell = running->cells[reader.read_varint()];
+                cell.page_id = static_cast<int>(reader.read_signed_varint());
+                cell.authority = reader.read_byte();
+                cell.physical_address = cell.authority == 0 ? -1 : static_cast<int>(reader.read_signed_varint());
+            }
+        }
+
+        if (cycle < from_cycle) continue;
+        if (to_cycle >= 0 && cycle > to_cycle) break;
+
+        // print_status의 텍스트 형식과 동일하게 출력
+        out.write("[cycle #");
+        out.write_int(static_cast<int>(cycle));
+        out.write("]\n");
+
+        out.write("1. mode: ");
+        out.write(flag & TRACE_FLAG_USER_MODE ? "user" : "kernel");
+        out.write('\n');
+
+        out.write("2. command: ");
+        out.write(strings[command_id]);
+        out.write('\n');
+
+        if (running == nullptr) {
+            out.write("3. running: none\n");
+        } else {
+            out.write("3. running: ");
+            out.write_int(running_pid);
+            out.write('(');
+            out.write(strings[running->name_id]);
+            out.write(", ");
+            out.write_int(running->ppid);
+            out.write(")\n");
+        }
+
+        out.write("4. physical memory:\n");
+        out.write('|');
+        for (int i = 0; i < physical_memory_size; i++) {
+            if (physical_memory[i].first == -1) {
+                out.write('-');
+            } else {
+                out.write_int(physical_memory[i].first);
+                out.write('(');
+                out.write_int(physical_memory[i].second);
+                out.write(')');
+            }
+            out.write(separator(i));
+        }
+        out.write('\n');
+
+        if (running == nullptr) {
+            out.write('\n');
+            continue;
+        }
+
+        out.write("5. virtual memory:\n");
+        out.write('|');
+        for (int i = 0; i < virtual_memory_size; i++) {
+            if (running->cells[i].page_id == -1) {
+                out.write('-');
+            } else {
+                out.write_int(running->cells[i].page_id);
+            }
+            out.write(separator(i));
+        }
+        out.write('\n');
+
+        out.write("6. page table:\n");
+        out.write('|');
+        for (int i = 0; i < virtual_memory_size; i++) {
+            if (running->cells[i].authority == 0 || running->cells[i].physical_address == -1) {
+                out.write('-');
+            } else {
+                out.write_int(running->cells[i].physical_address);
+            }
+            out.write(separator(i));
+        }
+        out.write('\n');
+
+        out.write('|');
+        for (int i = 0; i < virtual_memory_size; i++) {
+            if (running->cells[i].authority == 0) {
+                out.write('-');
+            } else {
+                out.write(running->cells[i].authority);
+            }
+            out.write(separator(i));
+        }
+        out.write('\n');
+
+        out.write('\n');
+    }
+
+    out.close();
+    fclose(input);
+    return 0;
+}
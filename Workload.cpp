@@ -0,0 +1,311 @@
+#include "Workload.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <vector>
+
+access_pattern str_to_access_pattern(const std::string& pattern_str) {
+    if (pattern_str == UNIFORM_ACCESS_STRING) return Uniform_access;
+    if (pattern_str == SEQUENTIAL_ACCESS_STRING) return Sequential_access;
+    if (pattern_str == ZIPFIAN_ACCESS_STRING) return Zipfian_access;
+    if (pattern_str == WORKING_SET_ACCESS_STRING) return Working_set_access;
+    if (pattern_str == FORK_HEAVY_ACCESS_STRING) return Fork_heavy_access;
+
+    fprintf(stderr, "Argument does not match access pattern\n");
+    throw;
+}
+
+std::string access_pattern_to_str(access_pattern pattern) {
+    switch (pattern) {
+        case Sequential_access:
+            return SEQUENTIAL_ACCESS_STRING;
+        case Zipfian_access:
+            return ZIPFIAN_ACCESS_STRING;
+        case Working_set_access:
+            return WORKING_SET_ACCESS_STRING;
+        case Fork_heavy_access:
+            return FORK_HEAVY_ACCESS_STRING;
+        default:
+            return UNIFORM_ACCESS_STRING;
+    }
+}
+
+/**
+ * splitmix64 난수 생성기\n
+ * 표준 라이브러리 분포는 구현마다 결과가 다를 수 있으므로 직접 구간을 나눈다.
+ */
+class WorkloadRandom {
+private:
+    uint64_t state;
+
+public:
+    explicit WorkloadRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * [0, bound) 구간의 정수
+     */
+    int below(int bound) {
+        return (int) (next() % (uint64_t) bound);
+    }
+
+    /**
+     * [low, high] 구간의 정수
+     */
+    int between(int low, int high) {
+        return low + below(high - low + 1);
+    }
+
+    /**
+     * [0, 1) 구간의 실수
+     */
+    double unit() {
+        return (double) (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+/**
+ * 프로그램 하나를 만드는 동안의 가상 메모리 상태 (시뮬레이터의 memory_allocate와 같은 first fit)
+ */
+struct ProgramMemory {
+    std::vector<int> virtual_memory; // 가상 메모리 주소 -> page id, 없으면 -1
+    std::vector<int> pages; // 접근할 수 있는 page id
+    std::map<int, std::vector<int>> own_allocations; // 프로세스가 직접 할당한 allocation id -> page id
+    int next_page_id = 0;
+    int next_allocation_id = 0;
+
+    explicit ProgramMemory(int virtual_memory_size) : virtual_memory(virtual_memory_size, -1) {}
+
+    /**
+     * allocation_size개의 연속된 빈 가상 메모리 주소 중 가장 낮은 시작 주소
+     * @return 시작 주소, 없으면 -1
+     */
+    int first_fit(int allocation_size) const {
+        int run_length = 0;
+        for (int i = 0; i < (int) virtual_memory.size(); i++) {
+            run_length = virtual_memory[i] == -1 ? run_length + 1 : 0;
+            if (run_length == allocation_size) return i - allocation_size + 1;
+        }
+        return -1;
+    }
+
+    void allocate(int begin, int allocation_size) {
+        auto& allocation = own_allocations[next_allocation_id++];
+        for (int i = 0; i < allocation_size; i++) {
+            virtual_memory[begin + i] = next_page_id;
+            pages.push_back(next_page_id);
+            allocation.push_back(next_page_id++);
+        }
+    }
+
+    void release(int allocation_id) {
+        for (int page_id: own_allocations[allocation_id]) {
+            for (auto& page: virtual_memory) {
+                if (page == page_id) page = -1;
+            }
+            for (size_t i = 0; i < pages.size(); i++) {
+                if (pages[i] == page_id) {
+                    pages.erase(pages.begin() + (long) i);
+                    break;
+                }
+            }
+        }
+        own_allocations.erase(allocation_id);
+    }
+};
+
+static bool write_program(const std::string& path, const std::vector<std::string>& lines) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+    for (const auto& line: lines) {
+        fprintf(file, "%s\n", line.c_str());
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * 프로그램 하나에서 다음에 접근할 페이지를 고르는 위치
+ */
+struct AccessCursor {
+    int position = 0; // Sequential_access, Working_set_access에서 다음에 접근할 순번
+    int window = 0; // Working_set_access에서 현재 집합의 시작 순번
+    int accesses = 0;
+    int inherited_pages = 0; // fork 시점에 물려받은 페이지 수 (pages 앞쪽에 있으며 해제하지 않음)
+};
+
+/**
+ * 프로그램 디렉토리 생성기\n
+ * 자식 프로그램은 init의 fork_and_exec 순서대로 생성되므로 같은 시드면 같은 이름과 내용이 나온다.
+ */
+class WorkloadGenerator {
+private:
+    const WorkloadOptions& options;
+    std::string directory;
+    WorkloadRandom random;
+    // Zipf 분포의 누적 가중치 (i번째 원소 = 1..i+1 순위 가중치의 합)
+    std::vector<double> zipf_cdf;
+    int program_count = 0;
+
+    int choose_page(const ProgramMemory& memory, AccessCursor& cursor) {
+        int page_count = (int) memory.pages.size();
+        int index = 0;
+        switch (options.pattern) {
+            case Sequential_access:
+                index = cursor.position++ % page_count;
+                break;
+            case Zipfian_access: {
+                int rank_count = std::min(page_count, (int) zipf_cdf.size());
+                double target = random.unit() * zipf_cdf[rank_count - 1];
+                index = (int) (std::upper_bound(zipf_cdf.begin(), zipf_cdf.begin() + rank_count, target)
+                               - zipf_cdf.begin());
+                index = std::min(index, rank_count - 1);
+                break;
+            }
+            case Working_set_access: {
+                int set_size = std::max(1, std::min(options.working_set_size, page_count));
+                if (cursor.accesses > 0 && options.phase_length > 0 && cursor.accesses % options.phase_length == 0) {
+                    cursor.window += set_size;
+                }
+                index = (cursor.window + cursor.position++ % set_size) % page_count;
+                break;
+            }
+            case Fork_heavy_access:
+                // 절반은 물려받은 (공유 중인) 페이지
+                if (cursor.inherited_pages > 0 && random.below(2) == 0) {
+                    index = random.below(cursor.inherited_pages);
+                } else {
+                    index = random.below(page_count);
+                }
+                break;
+            default:
+                index = random.below(page_count);
+                break;
+        }
+        cursor.accesses++;
+        return memory.pages[index];
+    }
+
+    /**
+     * init의 자식 프로그램 하나 생성\n
+     * 시뮬레이터의 CoW는 init과 그 자식 사이의 공유만 다루므로 자식은 다시 fork 하지 않는다.
+     * @param memory fork 시점에 물려받은 init의 메모리
+     * @return 프로그램 이름, 파일을 쓰지 못하면 빈 문자열
+     */
+    std::string child_program(ProgramMemory memory) {
+        std::string name = "w" + std::to_string(++program_count);
+        memory.own_allocations.clear();
+        AccessCursor cursor;
+        cursor.inherited_pages = (int) memory.pages.size();
+        std::vector<std::string> lines;
+        while ((int) lines.size() < options.instruction_count) {
+            int choice = random.below(100);
+            if (choice < 10) {
+                int allocation_size = random.between(1, 4);
+                if ((int) memory.pages.size() + allocation_size > options.max_live_pages
+                    || memory.first_fit(allocation_size) == -1) {
+                    // 스트리밍: 가장 오래된 할당을 해제해서 자리를 만듦
+                    if (options.pattern == Sequential_access && !memory.own_allocations.empty()) {
+                        int allocation_id = memory.own_allocations.begin()->first;
+                        memory.release(allocation_id);
+                        lines.push_back("memory_release " + std::to_string(allocation_id));
+                    }
+                    continue;
+                }
+                memory.allocate(memory.first_fit(allocation_size), allocation_size);
+                lines.push_back("memory_allocate " + std::to_string(allocation_size));
+            } else if (choice < 16) {
+                if (memory.own_allocations.empty()) continue;
+                auto allocation = memory.own_allocations.begin();
+                std::advance(allocation, random.below((int) memory.own_allocations.size()));
+                int allocation_id = allocation->first;
+                memory.release(allocation_id);
+                lines.push_back("memory_release " + std::to_string(allocation_id));
+            } else if (choice < 71) {
+                if (memory.pages.empty()) continue;
+                bool write = random.below(100) < options.write_percent;
+                int page_id = choose_page(memory, cursor);
+                lines.push_back((write ? "memory_write " : "memory_read ") + std::to_string(page_id));
+            } else if (choice < 92) {
+                lines.push_back("run " + std::to_string(random.between(1, 8)));
+            } else {
+                lines.push_back("sleep " + std::to_string(random.between(1, 8)));
+            }
+        }
+        lines.push_back("exit");
+        return write_program(directory + "/" + name, lines) ? name : "";
+    }
+
+    /**
+     * Fork_heavy_access에서 init이 fork 사이에 실행하는 명령어\n
+     * 방금 자식과 공유하게 된 페이지에 쓰거나 (init 쪽 protection fault) 다음 자식과 공유할 페이지를 새로 할당한다.
+     */
+    void fork_interval_program(ProgramMemory& memory, AccessCursor& cursor, std::vector<std::string>& lines) {
+        int instruction_count = random.between(1, std::max(1, options.fork_interval));
+        for (int i = 0; i < instruction_count; i++) {
+            int allocation_size = random.between(1, 2);
+            if (random.below(4) == 0 && (int) memory.pages.size() + allocation_size <= options.max_live_pages
+                && memory.first_fit(allocation_size) != -1) {
+                memory.allocate(memory.first_fit(allocation_size), allocation_size);
+                lines.push_back("memory_allocate " + std::to_string(allocation_size));
+            } else if (!memory.pages.empty()) {
+                bool write = random.below(100) < options.write_percent;
+                int page_id = choose_page(memory, cursor);
+                lines.push_back((write ? "memory_write " : "memory_read ") + std::to_string(page_id));
+            } else {
+                lines.push_back("run " + std::to_string(random.between(1, 4)));
+            }
+        }
+    }
+
+public:
+    WorkloadGenerator(const std::string& directory, const WorkloadOptions& options)
+            : options(options), directory(directory), random(options.seed) {
+        double sum = 0;
+        for (int rank = 1; rank <= std::max(1, options.virtual_memory_size); rank++) {
+            sum += 1.0 / std::pow((double) rank, options.zipf_exponent);
+            zipf_cdf.push_back(sum);
+        }
+    }
+
+    bool write() {
+        ProgramMemory init_memory(options.virtual_memory_size);
+        std::vector<std::string> init_lines;
+
+        int shared_pages = std::min(options.shared_pages, options.virtual_memory_size);
+        if (shared_pages > 0) {
+            init_memory.allocate(0, shared_pages);
+            init_lines.push_back("memory_allocate " + std::to_string(shared_pages));
+        }
+
+        // 자식은 init이 할당한 페이지를 물려받지만 해제하지는 않는다
+        AccessCursor init_cursor;
+        for (int i = 0; i < options.process_count; i++) {
+            std::string child = child_program(init_memory);
+            if (child.empty()) return false;
+            init_lines.push_back("fork_and_exec " + child);
+            if (options.pattern == Fork_heavy_access) fork_interval_program(init_memory, init_cursor, init_lines);
+        }
+        for (int i = 0; i < options.process_count; i++) {
+            init_lines.push_back("wait");
+        }
+        init_lines.push_back("exit");
+        return write_program(directory + "/init", init_lines);
+    }
+};
+
+bool write_workload(const std::string& directory, const WorkloadOptions& options) {
+    WorkloadGenerator generator(directory, options);
+    return generator.write();
+}
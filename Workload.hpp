@@ -0,0 +1,66 @@
+#ifndef HW3_WORKLOAD_HPP
+#define HW3_WORKLOAD_HPP
+
+#include <string>
+#include <cstdint>
+
+/**
+ * 합성 워크로드의 페이지 접근 패턴
+ */
+enum access_pattern {
+    Uniform_access, // 살아 있는 페이지 중 균등하게 선택
+    Sequential_access, // 페이지를 순서대로 훑고, 공간이 없으면 가장 오래된 할당을 해제하고 새로 할당 (스트리밍)
+    Zipfian_access, // 먼저 할당된 페이지일수록 자주 접근 (Zipf 분포)
+    Working_set_access, // 작은 페이지 집합을 반복해서 접근하고, 일정 접근마다 집합을 옮김
+    Fork_heavy_access, // init이 fork 사이사이 공유 페이지에 쓰고, 자식은 물려받은 페이지 위주로 쓰기 (CoW protection fault 유발)
+};
+
+const std::string UNIFORM_ACCESS_STRING = "uniform";
+const std::string SEQUENTIAL_ACCESS_STRING = "sequential";
+const std::string ZIPFIAN_ACCESS_STRING = "zipfian";
+const std::string WORKING_SET_ACCESS_STRING = "working-set";
+const std::string FORK_HEAVY_ACCESS_STRING = "fork-heavy";
+
+access_pattern str_to_access_pattern(const std::string& pattern_str);
+
+std::string access_pattern_to_str(access_pattern pattern);
+
+/**
+ * 합성 워크로드 구성\n
+ * init이 페이지를 할당한 뒤 자식 프로세스를 모두 fork_and_exec 하고, 각 자식은 물려받은 페이지와
+ * 자기가 할당한 페이지에 memory_read/memory_write, run, sleep, memory_allocate/memory_release를 섞어 실행한다.
+ */
+struct WorkloadOptions {
+    // 난수 시드 (같은 시드와 구성이면 같은 프로그램 파일이 생성됨)
+    uint64_t seed = 1;
+    access_pattern pattern = Uniform_access;
+    // init이 만드는 자식 프로세스 수
+    int process_count = 8;
+    // 자식 프로세스 하나의 명령어 수 (wait, exit 제외)
+    int instruction_count = 256;
+    // 프로세스 하나가 동시에 가질 수 있는 최대 페이지 수 (가상 메모리 크기 이하)
+    int max_live_pages = 12;
+    // fork 전에 init이 할당해서 자식과 공유하는 페이지 수
+    int shared_pages = 4;
+    // 가상 메모리 크기
+    int virtual_memory_size = 32;
+    // 메모리 접근 중 memory_write의 비율 (%)
+    int write_percent = 36;
+    // Zipfian_access: Zipf 분포의 지수
+    double zipf_exponent = 1.0;
+    // Working_set_access: 반복해서 접근하는 페이지 수와 집합을 옮기기까지의 접근 수
+    int working_set_size = 4;
+    int phase_length = 64;
+    // Fork_heavy_access: init이 fork 하나마다 실행하는 최대 명령어 수
+    int fork_interval = 4;
+};
+
+/**
+ * 프로그램 디렉토리에 워크로드 프로그램 파일(init, w1, w2, ...) 생성
+ * @param directory 프로그램 디렉토리 (이미 존재해야 함)
+ * @param options 워크로드 구성
+ * @return 모든 파일을 썼는지
+ */
+bool write_workload(const std::string& directory, const WorkloadOptions& options);
+
+#endif //HW3_WORKLOAD_HPP
@@ -0,0 +1,127 @@
+// 합성 워크로드 프로그램 디렉토리를 만드는 도구
+// 사용법: workload_gen [--pattern=uniform,sequential,zipfian,working-set,fork-heavy] [--seed=N] [--count=N]
+//                      [--processes=N] [--instructions=N] [--max-pages=N] [--shared-pages=N] [--virtual-memory=N]
+//                      [--write-percent=N] [--zipf-exponent=X] [--working-set=N] [--phase-length=N]
+//                      [--fork-interval=N] <directory>
+// 패턴과 시드(seed, seed + 1, ..., seed + count - 1) 조합이 하나면 directory에 바로 쓰고,
+// 여럿이면 directory/<패턴>-<시드> 디렉토리를 조합마다 만든다. (project3 --sweep 입력으로 사용)
+
+#include "Workload.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+#include <vector>
+
+const std::string PATTERN_OPTION = "--pattern=";
+const std::string SEED_OPTION = "--seed=";
+const std::string COUNT_OPTION = "--count=";
+const std::string PROCESSES_OPTION = "--processes=";
+const std::string INSTRUCTIONS_OPTION = "--instructions=";
+const std::string MAX_PAGES_OPTION = "--max-pages=";
+const std::string SHARED_PAGES_OPTION = "--shared-pages=";
+const std::string VIRTUAL_MEMORY_OPTION = "--virtual-memory=";
+const std::string WRITE_PERCENT_OPTION = "--write-percent=";
+const std::string ZIPF_EXPONENT_OPTION = "--zipf-exponent=";
+const std::string WORKING_SET_OPTION = "--working-set=";
+const std::string PHASE_LENGTH_OPTION = "--phase-length=";
+const std::string FORK_INTERVAL_OPTION = "--fork-interval=";
+
+static void usage() {
+    fprintf(stderr, "usage: workload_gen [--pattern=P,...] [--seed=N] [--count=N] [--processes=N] [--instructions=N]\n"
+                    "                    [--max-pages=N] [--shared-pages=N] [--virtual-memory=N] [--write-percent=N]\n"
+                    "                    [--zipf-exponent=X] [--working-set=N] [--phase-length=N] [--fork-interval=N]\n"
+                    "                    <directory>\n");
+    exit(1);
+}
+
+static bool match_option(const std::string& option, const std::string& prefix, std::string& value) {
+    if (option.compare(0, prefix.size(), prefix) != 0) return false;
+    value = option.substr(prefix.size());
+    return true;
+}
+
+/**
+ * 0 이상의 정수 옵션 값
+ */
+static long long parse_count(const std::string& value) {
+    size_t parsed_length = 0;
+    long long count = -1;
+    try {
+        count = std::stoll(value, &parsed_length);
+    } catch (const std::exception&) {
+        parsed_length = 0;
+    }
+    if (parsed_length != value.size() || count < 0) usage();
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    WorkloadOptions options;
+    std::vector<access_pattern> patterns;
+    long long count = 1;
+    std::string directory;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        std::string value;
+        if (match_option(option, PATTERN_OPTION, value)) {
+            std::stringstream stream(value);
+            std::string pattern;
+            while (getline(stream, pattern, ',')) {
+                if (!pattern.empty()) patterns.push_back(str_to_access_pattern(pattern));
+            }
+        } else if (match_option(option, SEED_OPTION, value)) {
+            options.seed = (uint64_t) parse_count(value);
+        } else if (match_option(option, COUNT_OPTION, value)) {
+            count = parse_count(value);
+        } else if (match_option(option, PROCESSES_OPTION, value)) {
+            options.process_count = (int) parse_count(value);
+        } else if (match_option(option, INSTRUCTIONS_OPTION, value)) {
+            options.instruction_count = (int) parse_count(value);
+        } else if (match_option(option, MAX_PAGES_OPTION, value)) {
+            options.max_live_pages = (int) parse_count(value);
+        } else if (match_option(option, SHARED_PAGES_OPTION, value)) {
+            options.shared_pages = (int) parse_count(value);
+        } else if (match_option(option, VIRTUAL_MEMORY_OPTION, value)) {
+            options.virtual_memory_size = (int) parse_count(value);
+        } else if (match_option(option, WRITE_PERCENT_OPTION, value)) {
+            options.write_percent = (int) parse_count(value);
+        } else if (match_option(option, ZIPF_EXPONENT_OPTION, value)) {
+            options.zipf_exponent = atof(value.c_str());
+        } else if (match_option(option, WORKING_SET_OPTION, value)) {
+            options.working_set_size = (int) parse_count(value);
+        } else if (match_option(option, PHASE_LENGTH_OPTION, value)) {
+            options.phase_length = (int) parse_count(value);
+        } else if (match_option(option, FORK_INTERVAL_OPTION, value)) {
+            options.fork_interval = (int) parse_count(value);
+        } else if (option.compare(0, 2, "--") == 0 || !directory.empty()) {
+            usage();
+        } else {
+            directory = option;
+        }
+    }
+    if (patterns.empty()) patterns.push_back(options.pattern);
+    // 공유 페이지와 새로 할당하는 페이지가 모두 가상 메모리 안에 들어가야 함
+    if (directory.empty() || count < 1 || options.virtual_memory_size < 1
+        || options.max_live_pages > options.virtual_memory_size || options.shared_pages > options.max_live_pages) {
+        usage();
+    }
+
+    bool single = patterns.size() == 1 && count == 1;
+    for (access_pattern pattern: patterns) {
+        for (long long i = 0; i < count; i++) {
+            WorkloadOptions workload = options;
+            workload.pattern = pattern;
+            workload.seed = options.seed + (uint64_t) i;
+            std::string workload_directory = single ? directory : directory + "/" + access_pattern_to_str(pattern)
+                                                                  + "-" + std::to_string(workload.seed);
+            std::error_code error;
+            std::filesystem::create_directories(workload_directory, error);
+            if (error || !write_workload(workload_directory, workload)) {
+                fprintf(stderr, "cannot write workload to %s\n", workload_directory.c_str());
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
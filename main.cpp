@@ -1,21 +1,224 @@
 #include "Run.hpp"
+#include "Sweep.hpp"
+#include <sstream>
+#include <filesystem>
 
 using namespace std;
 
+const string TRACE_OPTION = "--trace=";
+const string OUTPUT_OPTION = "--output=";
+const string VICTIM_SEARCH_OPTION = "--victim-search=";
+const string VIRTUAL_MEMORY_OPTION = "--virtual-memory=";
+const string PHYSICAL_MEMORY_OPTION = "--physical-memory=";
+const string SWAP_SPACE_OPTION = "--swap-space=";
+const string FRAME_UNIT_OPTION = "--frame-unit=";
+const string SWEEP_OPTION = "--sweep";
+const string POLICIES_OPTION = "--policies=";
+const string JOBS_OPTION = "--jobs=";
+const string STATS_OPTION = "--stats=";
+const string STATS_OUTPUT_OPTION = "--stats-output=";
+const string TIMERS_OPTION = "--timers";
+
+/**
+ * "--이름=값" 형식의 옵션이면 값을 꺼낸다
+ * @param option 명령행 인자
+ * @param prefix 옵션 이름 ("--이름=")
+ * @param value 옵션 값
+ * @return 옵션 이름이 일치하는지
+ */
+static bool match_option(const string& option, const string& prefix, string& value) {
+    if (option.compare(0, prefix.size(), prefix) != 0) return false;
+    value = option.substr(prefix.size());
+    return true;
+}
+
+/**
+ * 양의 정수 옵션 값 (메모리 구성, 워커 수)
+ */
+static int parse_size(const string& value) {
+    size_t parsed_length = 0;
+    int size = 0;
+    try {
+        size = stoi(value, &parsed_length);
+    } catch (const exception&) {
+        parsed_length = 0;
+    }
+    if (parsed_length != value.size() || size <= 0) {
+        fprintf(stderr, "please check arguments\n");
+        exit(1);
+    }
+    return size;
+}
+
+/**
+ * 쉼표로 구분된 값 목록
+ */
+static vector<string> split_list(const string& value) {
+    vector<string> items;
+    stringstream stream(value);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+/**
+ * 스윕 모드 실행 ex) --sweep --policies=lru,fifo --physical-memory=8,16 --jobs=8 --output=sweep dir1 dir2 ...\n
+ * 옵션이 아닌 인자는 모두 프로그램 디렉토리로 취급하며, --physical-memory는 쉼표로 여러 크기를 받는다.
+ */
+static int run_sweep(int argc, char* argv[]) {
+    SweepOptions options;
+    bool geometry_changed = false;
+    for (int i = 2; i < argc; i++) {
+        string option = string(argv[i]);
+        string value;
+        if (match_option(option, TRACE_OPTION, value)) {
+            options.mode = str_to_trace_mode(value);
+        } else if (match_option(option, OUTPUT_OPTION, value)) {
+            options.output_directory = value;
+        } else if (match_option(option, VICTIM_SEARCH_OPTION, value)) {
+            options.search = str_to_victim_search(value);
+        } else if (match_option(option, POLICIES_OPTION, value)) {
+            options.policies = split_list(value);
+            for (const auto& policy: options.policies) str_to_policy(policy);
+        } else if (match_option(option, JOBS_OPTION, value)) {
+            options.jobs = parse_size(value);
+        } else if (match_option(option, STATS_OPTION, value)) {
+            options.write_stats = true;
+            options.stats_mode = str_to_stats_format(value);
+        } else if (option == TIMERS_OPTION) {
+            options.timers_enabled = true;
+        } else if (match_option(option, VIRTUAL_MEMORY_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            options.geometry.virtual_memory_size = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else if (match_option(option, PHYSICAL_MEMORY_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            for (const auto& size: split_list(value)) options.physical_memory_sizes.push_back(parse_size(size));
+#endif
+            geometry_changed = true;
+        } else if (match_option(option, SWAP_SPACE_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            options.geometry.swap_space_size = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else if (match_option(option, FRAME_UNIT_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            options.geometry.print_frame_unit = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else if (option.compare(0, 2, "--") == 0) {
+            fprintf(stderr, "please check arguments\n");
+            exit(1);
+        } else if (filesystem::is_directory(option)) {
+            options.directories.push_back(option);
+        } else {
+            fprintf(stderr, "%s is not a program directory\n", option.c_str());
+            exit(1);
+        }
+    }
+#ifdef FIXED_GEOMETRY
+    if (geometry_changed) {
+        fprintf(stderr, "memory geometry is fixed in this build\n");
+        exit(1);
+    }
+#else
+    (void) geometry_changed;
+#endif
+    if (options.directories.empty() || options.policies.empty()) {
+        fprintf(stderr, "please check arguments\n");
+        exit(1);
+    }
+
+    auto results = sweep(options);
+    print_sweep_summary(results, stdout);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     // 마지막에 '/'가 붙지 않아도 실행할 수 있도록 변경 => 입력에 디렉토리가 표시가 되어야 함 ex) /home/test/programs
+    // 옵션은 디렉토리 앞에 위치 ex) --trace=binary --physical-memory=4096 /home/test/programs lru
+
+    if (argc >= 2 && string(argv[1]) == SWEEP_OPTION) {
+        return run_sweep(argc, argv);
+    }
 
     if (argc < 3) {
         fprintf(stderr, "please check arguments\n");
         exit(1);
     }
 
+    trace_mode mode = Text_trace;
+    victim_search search = Indexed_victim_search;
+    MemoryGeometry geometry;
+    bool geometry_changed = false;
+    string result_filename;
+    Simulator sim;
+    bool write_stats = false;
+    for (int i = 1; i < argc - 2; i++) {
+        string option = string(argv[i]);
+        string value;
+        if (match_option(option, TRACE_OPTION, value)) {
+            mode = str_to_trace_mode(value);
+        } else if (match_option(option, OUTPUT_OPTION, value)) {
+            result_filename = value;
+        } else if (match_option(option, VICTIM_SEARCH_OPTION, value)) {
+            search = str_to_victim_search(value);
+        } else if (match_option(option, STATS_OPTION, value)) {
+            write_stats = true;
+            sim.stats_mode = str_to_stats_format(value);
+        } else if (match_option(option, STATS_OUTPUT_OPTION, value)) {
+            write_stats = true;
+            sim.stats_filename = value;
+        } else if (option == TIMERS_OPTION) {
+            sim.timers_enabled = true;
+        } else if (match_option(option, VIRTUAL_MEMORY_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            geometry.virtual_memory_size = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else if (match_option(option, PHYSICAL_MEMORY_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            geometry.physical_memory_size = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else if (match_option(option, SWAP_SPACE_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            geometry.swap_space_size = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else if (match_option(option, FRAME_UNIT_OPTION, value)) {
+#ifndef FIXED_GEOMETRY
+            geometry.print_frame_unit = parse_size(value);
+#endif
+            geometry_changed = true;
+        } else {
+            fprintf(stderr, "please check arguments\n");
+            exit(1);
+        }
+    }
+#ifdef FIXED_GEOMETRY
+    if (geometry_changed) {
+        fprintf(stderr, "memory geometry is fixed in this build\n");
+        exit(1);
+    }
+#else
+    (void) geometry_changed;
+#endif
+    if (result_filename.empty()) {
+        result_filename = mode == Binary_trace ? "result.bin" : "result";
+    }
+
+    if (write_stats && sim.stats_filename.empty()) {
+        sim.stats_filename = "stats." + stats_format_to_str(sim.stats_mode);
+    }
+
     string path = string(argv[argc - 2]) + "/";
     string replacement_policy = string(argv[argc - 1]);
 
 
-    run(path, replacement_policy);
+    run(sim, path, replacement_policy, result_filename, mode, search, geometry);
     return 0;
 }
-
-